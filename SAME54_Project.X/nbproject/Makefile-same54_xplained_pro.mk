@@ -57,17 +57,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=../src/common/board.c ../src/common/cpu.c ../src/common/delay.c ../src/common/systick.c ../src/drivers/qspi/qspi_flash.c ../src/drivers/qspi/qspi_hw.c ../src/drivers/rtcc.c ../src/drivers/uart.c ../src/drivers/uart_dma.c ../src/main.c ../src/drivers/qspi/sst26/sst26.c ../src/drivers/qspi/n25q/n25q256a.c
+SOURCEFILES_QUOTED_IF_SPACED=../src/common/board.c ../src/common/cpu.c ../src/common/delay.c ../src/common/systick.c ../src/drivers/qspi/qspi_flash.c ../src/drivers/qspi/qspi_hw.c ../src/drivers/rtcc.c ../src/drivers/uart.c ../src/drivers/uart_dma.c ../src/main.c ../src/drivers/qspi/sst26/sst26.c ../src/drivers/qspi/n25q/n25q256a.c ../src/drivers/qspi/qspi_spi_dma.c ../src/drivers/qspi/qspi_bench.c ../src/drivers/qspi/qspi_sfdp.c ../src/drivers/qspi/qspi_job.c ../src/drivers/qspi/qspi_wear.c ../src/drivers/qspi/qspi_crc32.c ../src/drivers/qspi/qspi_crc_hw.c ../src/drivers/qspi/qspi_log.c ../src/drivers/qspi/qspi_index.c ../src/drivers/qspi/qspi_cache.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/394045403/board.o ${OBJECTDIR}/_ext/394045403/cpu.o ${OBJECTDIR}/_ext/394045403/delay.o ${OBJECTDIR}/_ext/394045403/systick.o ${OBJECTDIR}/_ext/1151356775/qspi_flash.o ${OBJECTDIR}/_ext/1151356775/qspi_hw.o ${OBJECTDIR}/_ext/1639450193/rtcc.o ${OBJECTDIR}/_ext/1639450193/uart.o ${OBJECTDIR}/_ext/1639450193/uart_dma.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1254920606/sst26.o ${OBJECTDIR}/_ext/456336618/n25q256a.o
-POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/394045403/board.o.d ${OBJECTDIR}/_ext/394045403/cpu.o.d ${OBJECTDIR}/_ext/394045403/delay.o.d ${OBJECTDIR}/_ext/394045403/systick.o.d ${OBJECTDIR}/_ext/1151356775/qspi_flash.o.d ${OBJECTDIR}/_ext/1151356775/qspi_hw.o.d ${OBJECTDIR}/_ext/1639450193/rtcc.o.d ${OBJECTDIR}/_ext/1639450193/uart.o.d ${OBJECTDIR}/_ext/1639450193/uart_dma.o.d ${OBJECTDIR}/_ext/1360937237/main.o.d ${OBJECTDIR}/_ext/1254920606/sst26.o.d ${OBJECTDIR}/_ext/456336618/n25q256a.o.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/394045403/board.o ${OBJECTDIR}/_ext/394045403/cpu.o ${OBJECTDIR}/_ext/394045403/delay.o ${OBJECTDIR}/_ext/394045403/systick.o ${OBJECTDIR}/_ext/1151356775/qspi_flash.o ${OBJECTDIR}/_ext/1151356775/qspi_hw.o ${OBJECTDIR}/_ext/1639450193/rtcc.o ${OBJECTDIR}/_ext/1639450193/uart.o ${OBJECTDIR}/_ext/1639450193/uart_dma.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1254920606/sst26.o ${OBJECTDIR}/_ext/456336618/n25q256a.o ${OBJECTDIR}/_ext/1151356775/qspi_spi_dma.o ${OBJECTDIR}/_ext/1151356775/qspi_bench.o ${OBJECTDIR}/_ext/1151356775/qspi_sfdp.o ${OBJECTDIR}/_ext/1151356775/qspi_job.o ${OBJECTDIR}/_ext/1151356775/qspi_wear.o ${OBJECTDIR}/_ext/1151356775/qspi_crc32.o ${OBJECTDIR}/_ext/1151356775/qspi_crc_hw.o ${OBJECTDIR}/_ext/1151356775/qspi_log.o ${OBJECTDIR}/_ext/1151356775/qspi_index.o ${OBJECTDIR}/_ext/1151356775/qspi_cache.o
+POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/394045403/board.o.d ${OBJECTDIR}/_ext/394045403/cpu.o.d ${OBJECTDIR}/_ext/394045403/delay.o.d ${OBJECTDIR}/_ext/394045403/systick.o.d ${OBJECTDIR}/_ext/1151356775/qspi_flash.o.d ${OBJECTDIR}/_ext/1151356775/qspi_hw.o.d ${OBJECTDIR}/_ext/1639450193/rtcc.o.d ${OBJECTDIR}/_ext/1639450193/uart.o.d ${OBJECTDIR}/_ext/1639450193/uart_dma.o.d ${OBJECTDIR}/_ext/1360937237/main.o.d ${OBJECTDIR}/_ext/1254920606/sst26.o.d ${OBJECTDIR}/_ext/456336618/n25q256a.o.d ${OBJECTDIR}/_ext/1151356775/qspi_spi_dma.o.d ${OBJECTDIR}/_ext/1151356775/qspi_bench.o.d ${OBJECTDIR}/_ext/1151356775/qspi_sfdp.o.d ${OBJECTDIR}/_ext/1151356775/qspi_job.o.d ${OBJECTDIR}/_ext/1151356775/qspi_wear.o.d ${OBJECTDIR}/_ext/1151356775/qspi_crc32.o.d ${OBJECTDIR}/_ext/1151356775/qspi_crc_hw.o.d ${OBJECTDIR}/_ext/1151356775/qspi_log.o.d ${OBJECTDIR}/_ext/1151356775/qspi_index.o.d ${OBJECTDIR}/_ext/1151356775/qspi_cache.o.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/_ext/394045403/board.o ${OBJECTDIR}/_ext/394045403/cpu.o ${OBJECTDIR}/_ext/394045403/delay.o ${OBJECTDIR}/_ext/394045403/systick.o ${OBJECTDIR}/_ext/1151356775/qspi_flash.o ${OBJECTDIR}/_ext/1151356775/qspi_hw.o ${OBJECTDIR}/_ext/1639450193/rtcc.o ${OBJECTDIR}/_ext/1639450193/uart.o ${OBJECTDIR}/_ext/1639450193/uart_dma.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1254920606/sst26.o ${OBJECTDIR}/_ext/456336618/n25q256a.o
+OBJECTFILES=${OBJECTDIR}/_ext/394045403/board.o ${OBJECTDIR}/_ext/394045403/cpu.o ${OBJECTDIR}/_ext/394045403/delay.o ${OBJECTDIR}/_ext/394045403/systick.o ${OBJECTDIR}/_ext/1151356775/qspi_flash.o ${OBJECTDIR}/_ext/1151356775/qspi_hw.o ${OBJECTDIR}/_ext/1639450193/rtcc.o ${OBJECTDIR}/_ext/1639450193/uart.o ${OBJECTDIR}/_ext/1639450193/uart_dma.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1254920606/sst26.o ${OBJECTDIR}/_ext/456336618/n25q256a.o ${OBJECTDIR}/_ext/1151356775/qspi_spi_dma.o ${OBJECTDIR}/_ext/1151356775/qspi_bench.o ${OBJECTDIR}/_ext/1151356775/qspi_sfdp.o ${OBJECTDIR}/_ext/1151356775/qspi_job.o ${OBJECTDIR}/_ext/1151356775/qspi_wear.o ${OBJECTDIR}/_ext/1151356775/qspi_crc32.o ${OBJECTDIR}/_ext/1151356775/qspi_crc_hw.o ${OBJECTDIR}/_ext/1151356775/qspi_log.o ${OBJECTDIR}/_ext/1151356775/qspi_index.o ${OBJECTDIR}/_ext/1151356775/qspi_cache.o
 
 # Source Files
-SOURCEFILES=../src/common/board.c ../src/common/cpu.c ../src/common/delay.c ../src/common/systick.c ../src/drivers/qspi/qspi_flash.c ../src/drivers/qspi/qspi_hw.c ../src/drivers/rtcc.c ../src/drivers/uart.c ../src/drivers/uart_dma.c ../src/main.c ../src/drivers/qspi/sst26/sst26.c ../src/drivers/qspi/n25q/n25q256a.c
+SOURCEFILES=../src/common/board.c ../src/common/cpu.c ../src/common/delay.c ../src/common/systick.c ../src/drivers/qspi/qspi_flash.c ../src/drivers/qspi/qspi_hw.c ../src/drivers/rtcc.c ../src/drivers/uart.c ../src/drivers/uart_dma.c ../src/main.c ../src/drivers/qspi/sst26/sst26.c ../src/drivers/qspi/n25q/n25q256a.c ../src/drivers/qspi/qspi_spi_dma.c ../src/drivers/qspi/qspi_bench.c ../src/drivers/qspi/qspi_sfdp.c ../src/drivers/qspi/qspi_job.c ../src/drivers/qspi/qspi_wear.c ../src/drivers/qspi/qspi_crc32.c ../src/drivers/qspi/qspi_crc_hw.c ../src/drivers/qspi/qspi_log.c ../src/drivers/qspi/qspi_index.c ../src/drivers/qspi/qspi_cache.c
 
 # Pack Options 
 PACK_COMMON_OPTIONS=-I "${CMSIS_DIR}/CMSIS/Core/Include"
@@ -194,6 +194,76 @@ ${OBJECTDIR}/_ext/456336618/n25q256a.o: ../src/drivers/qspi/n25q/n25q256a.c  nbp
 	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/456336618/n25q256a.o.d" -o ${OBJECTDIR}/_ext/456336618/n25q256a.o ../src/drivers/qspi/n25q/n25q256a.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
 	@${FIXDEPS} "${OBJECTDIR}/_ext/456336618/n25q256a.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
 	
+${OBJECTDIR}/_ext/1151356775/qspi_spi_dma.o: ../src/drivers/qspi/qspi_spi_dma.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1151356775" 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_spi_dma.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_spi_dma.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/1151356775/qspi_spi_dma.o.d" -o ${OBJECTDIR}/_ext/1151356775/qspi_spi_dma.o ../src/drivers/qspi/qspi_spi_dma.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1151356775/qspi_spi_dma.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1151356775/qspi_bench.o: ../src/drivers/qspi/qspi_bench.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1151356775" 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_bench.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_bench.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/1151356775/qspi_bench.o.d" -o ${OBJECTDIR}/_ext/1151356775/qspi_bench.o ../src/drivers/qspi/qspi_bench.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1151356775/qspi_bench.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1151356775/qspi_sfdp.o: ../src/drivers/qspi/qspi_sfdp.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1151356775" 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_sfdp.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_sfdp.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/1151356775/qspi_sfdp.o.d" -o ${OBJECTDIR}/_ext/1151356775/qspi_sfdp.o ../src/drivers/qspi/qspi_sfdp.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1151356775/qspi_sfdp.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1151356775/qspi_job.o: ../src/drivers/qspi/qspi_job.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1151356775" 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_job.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_job.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/1151356775/qspi_job.o.d" -o ${OBJECTDIR}/_ext/1151356775/qspi_job.o ../src/drivers/qspi/qspi_job.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1151356775/qspi_job.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1151356775/qspi_wear.o: ../src/drivers/qspi/qspi_wear.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1151356775" 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_wear.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_wear.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/1151356775/qspi_wear.o.d" -o ${OBJECTDIR}/_ext/1151356775/qspi_wear.o ../src/drivers/qspi/qspi_wear.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1151356775/qspi_wear.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1151356775/qspi_crc32.o: ../src/drivers/qspi/qspi_crc32.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1151356775" 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_crc32.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_crc32.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/1151356775/qspi_crc32.o.d" -o ${OBJECTDIR}/_ext/1151356775/qspi_crc32.o ../src/drivers/qspi/qspi_crc32.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1151356775/qspi_crc32.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1151356775/qspi_crc_hw.o: ../src/drivers/qspi/qspi_crc_hw.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1151356775" 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_crc_hw.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_crc_hw.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/1151356775/qspi_crc_hw.o.d" -o ${OBJECTDIR}/_ext/1151356775/qspi_crc_hw.o ../src/drivers/qspi/qspi_crc_hw.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1151356775/qspi_crc_hw.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1151356775/qspi_log.o: ../src/drivers/qspi/qspi_log.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1151356775" 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_log.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_log.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/1151356775/qspi_log.o.d" -o ${OBJECTDIR}/_ext/1151356775/qspi_log.o ../src/drivers/qspi/qspi_log.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1151356775/qspi_log.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1151356775/qspi_index.o: ../src/drivers/qspi/qspi_index.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1151356775" 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_index.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_index.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/1151356775/qspi_index.o.d" -o ${OBJECTDIR}/_ext/1151356775/qspi_index.o ../src/drivers/qspi/qspi_index.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1151356775/qspi_index.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1151356775/qspi_cache.o: ../src/drivers/qspi/qspi_cache.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1151356775" 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_cache.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_cache.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/1151356775/qspi_cache.o.d" -o ${OBJECTDIR}/_ext/1151356775/qspi_cache.o ../src/drivers/qspi/qspi_cache.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1151356775/qspi_cache.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
 else
 ${OBJECTDIR}/_ext/394045403/board.o: ../src/common/board.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}/_ext/394045403" 
@@ -279,6 +349,76 @@ ${OBJECTDIR}/_ext/456336618/n25q256a.o: ../src/drivers/qspi/n25q/n25q256a.c  nbp
 	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/456336618/n25q256a.o.d" -o ${OBJECTDIR}/_ext/456336618/n25q256a.o ../src/drivers/qspi/n25q/n25q256a.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
 	@${FIXDEPS} "${OBJECTDIR}/_ext/456336618/n25q256a.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
 	
+${OBJECTDIR}/_ext/1151356775/qspi_spi_dma.o: ../src/drivers/qspi/qspi_spi_dma.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1151356775" 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_spi_dma.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_spi_dma.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/1151356775/qspi_spi_dma.o.d" -o ${OBJECTDIR}/_ext/1151356775/qspi_spi_dma.o ../src/drivers/qspi/qspi_spi_dma.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1151356775/qspi_spi_dma.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1151356775/qspi_bench.o: ../src/drivers/qspi/qspi_bench.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1151356775" 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_bench.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_bench.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/1151356775/qspi_bench.o.d" -o ${OBJECTDIR}/_ext/1151356775/qspi_bench.o ../src/drivers/qspi/qspi_bench.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1151356775/qspi_bench.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1151356775/qspi_sfdp.o: ../src/drivers/qspi/qspi_sfdp.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1151356775" 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_sfdp.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_sfdp.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/1151356775/qspi_sfdp.o.d" -o ${OBJECTDIR}/_ext/1151356775/qspi_sfdp.o ../src/drivers/qspi/qspi_sfdp.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1151356775/qspi_sfdp.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1151356775/qspi_job.o: ../src/drivers/qspi/qspi_job.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1151356775" 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_job.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_job.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/1151356775/qspi_job.o.d" -o ${OBJECTDIR}/_ext/1151356775/qspi_job.o ../src/drivers/qspi/qspi_job.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1151356775/qspi_job.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1151356775/qspi_wear.o: ../src/drivers/qspi/qspi_wear.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1151356775" 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_wear.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_wear.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/1151356775/qspi_wear.o.d" -o ${OBJECTDIR}/_ext/1151356775/qspi_wear.o ../src/drivers/qspi/qspi_wear.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1151356775/qspi_wear.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1151356775/qspi_crc32.o: ../src/drivers/qspi/qspi_crc32.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1151356775" 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_crc32.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_crc32.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/1151356775/qspi_crc32.o.d" -o ${OBJECTDIR}/_ext/1151356775/qspi_crc32.o ../src/drivers/qspi/qspi_crc32.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1151356775/qspi_crc32.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1151356775/qspi_crc_hw.o: ../src/drivers/qspi/qspi_crc_hw.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1151356775" 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_crc_hw.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_crc_hw.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/1151356775/qspi_crc_hw.o.d" -o ${OBJECTDIR}/_ext/1151356775/qspi_crc_hw.o ../src/drivers/qspi/qspi_crc_hw.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1151356775/qspi_crc_hw.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1151356775/qspi_log.o: ../src/drivers/qspi/qspi_log.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1151356775" 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_log.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_log.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/1151356775/qspi_log.o.d" -o ${OBJECTDIR}/_ext/1151356775/qspi_log.o ../src/drivers/qspi/qspi_log.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1151356775/qspi_log.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1151356775/qspi_index.o: ../src/drivers/qspi/qspi_index.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1151356775" 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_index.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_index.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/1151356775/qspi_index.o.d" -o ${OBJECTDIR}/_ext/1151356775/qspi_index.o ../src/drivers/qspi/qspi_index.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1151356775/qspi_index.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/_ext/1151356775/qspi_cache.o: ../src/drivers/qspi/qspi_cache.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}/_ext/1151356775" 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_cache.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1151356775/qspi_cache.o 
+	${MP_CC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -I"C:/Microchip/xc32/v4.50/pic32c/include/proc/SAME54" -MMD -MF "${OBJECTDIR}/_ext/1151356775/qspi_cache.o.d" -o ${OBJECTDIR}/_ext/1151356775/qspi_cache.o ../src/drivers/qspi/qspi_cache.c    -DXPRJ_same54_xplained_pro=$(CND_CONF)    $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	@${FIXDEPS} "${OBJECTDIR}/_ext/1151356775/qspi_cache.o.d" $(SILENT) -rsi ${MP_CC_DIR}../ 
+	
 endif
 
 # ------------------------------------------------------------------------------------
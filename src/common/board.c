@@ -10,6 +10,7 @@
 #include "../drivers/rtcc.h"
 #include "../drivers/qspi/qspi_flash.h"
 #include "../drivers/qspi/qspi_hw.h"
+#include "../drivers/qspi/qspi_spi_dma.h"
 
 /* Provided by your SysTick code */
 extern uint32_t millis(void);
@@ -73,6 +74,7 @@ void board_init(void)
         {
             printf("[QSPI] Init FAILED (JEDEC mismatch or bus issue)\r\n");
         }
+        QSPI_SPI_DMA_Init();
         
     #endif    
     CPU_LogClockOverview();
@@ -569,3 +569,25 @@ void CPU_PrintCacheMpuBootLine(void)
 }
 
 
+
+/**
+ * @brief Drop every CMCC line (no-op while the cache is off).
+ *
+ * Needed when memory behind the cache changes without the CPU writing it,
+ * e.g. QSPI flash programmed/erased under a memory-mapped view. The cache
+ * has to be disabled (CSTS clear) before MAINT0 is written.
+ */
+void CPU_CacheInvalidate(void)
+{
+    if ((CMCC_REGS->CMCC_CTRL & CMCC_CTRL_CEN_Msk) == 0U)
+        return;
+
+    CMCC_REGS->CMCC_CTRL &= ~CMCC_CTRL_CEN_Msk;
+    while ((CMCC_REGS->CMCC_SR & CMCC_SR_CSTS_Msk) != 0U)
+    {
+    }
+    CMCC_REGS->CMCC_MAINT0 = CMCC_MAINT0_INVALL_Msk;
+    CMCC_REGS->CMCC_CTRL |= CMCC_CTRL_CEN_Msk;
+    __DSB();
+    __ISB();
+}
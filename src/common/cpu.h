@@ -22,6 +22,8 @@
 void SystemConfigPerformance(void);
 void CPU_LogClockOverview(void);
 void CPU_PrintCacheMpuBootLine(void);
+/* Invalidate the CMCC after QSPI contents changed under it (no-op when off) */
+void CPU_CacheInvalidate(void);
 
 
 #endif //CPU_H
@@ -1,6 +1,24 @@
+#include <stdio.h>
 #include "n25q256a.h"
+#include "../../../common/systick.h"
 
 static bool s_use_quad_cmd = false; /* Harmony-style: after quad enable, use QUAD_CMD ops */
+static bool s_addr4 = false;        /* device in 4-byte address mode */
+
+/*
+ * Datasheet timing (N25Q256A): page program 0.5 ms typ / 5 ms max, subsector
+ * erase 0.25 s / 0.8 s, sector erase 0.7 s / 3 s, bulk erase 240 s / 480 s,
+ * WRNVCR up to 3 s, suspend 30 us max.
+ */
+static const qspi_busy_timing_t n25q_timing[QSPI_BUSY_OP_COUNT] =
+{
+    [QSPI_BUSY_PAGE_PROG]    = {    500UL,     20000UL },
+    [QSPI_BUSY_SECTOR_ERASE] = { 250000UL,   1000000UL },
+    [QSPI_BUSY_BLOCK_ERASE]  = { 700000UL,   3000000UL },
+    [QSPI_BUSY_CHIP_ERASE]   = { 240000000UL, N25Q_BULK_ERASE_TIMEOUT_MS * 1000UL },
+    [QSPI_BUSY_REG_WRITE]    = {      0UL,   3000000UL },
+    [QSPI_BUSY_SUSPEND]      = {      0UL,       500UL },
+};
 
 static inline void n25q_small_delay(void)
 {
@@ -15,10 +33,47 @@ static inline qspi_width_t n25q_cmd_width(void)
     return s_use_quad_cmd ? QSPI_WIDTH_QUAD_CMD : QSPI_WIDTH_SINGLE_BIT_SPI;
 }
 
+static inline qspi_addrlen_t n25q_addrlen(void)
+{
+    return s_addr4 ? QSPI_ADDRLEN_32BITS : QSPI_ADDRLEN_24BITS;
+}
+
+/* Bytes of [address, address + len) inside the AHB window (memory-mode reach) */
+static inline uint32_t n25q_window_len(uint32_t address, uint32_t len)
+{
+    if (address >= QSPI_HW_AHB_WINDOW_SIZE)
+    {
+        return 0U;
+    }
+    uint32_t room = QSPI_HW_AHB_WINDOW_SIZE - address;
+    return (len < room) ? len : room;
+}
+
+/* Fast read above the AHB window: register frames, same option code/dummies */
+static bool n25q_read_high(uint8_t *dst, uint32_t len, uint32_t address)
+{
+    if (!s_addr4)
+    {
+        return false;
+    }
+
+    return QSPI_HW_ReadAddrEx(N25Q_CMD_FAST_READ,
+                              n25q_cmd_width(),
+                              QSPI_ADDRLEN_32BITS,
+                              address,
+                              N25Q_XIP_MODE_EXIT,
+                              (uint8_t)QSPI_INSTRFRAME_OPTCODELEN_8BITS_Val,
+                              N25Q_FAST_READ_DUMMY_CYCLES - 2U,
+                              dst,
+                              (size_t)len);
+}
+
 bool N25Q_Reset(void)
 {
-    /* After reset, default back to 1-1-1 until quad is enabled again */
+    /* After reset, default back to 1-1-1 until quad is enabled again,
+     * and to the NVCR address mode (3-byte as shipped) */
     s_use_quad_cmd = false;
+    s_addr4 = false;
 
     if (!QSPI_HW_Command(N25Q_CMD_RESET_ENABLE, QSPI_WIDTH_SINGLE_BIT_SPI))
     {
@@ -89,16 +144,18 @@ bool N25Q_WriteEnable(void)
     return false;
 }
 
-bool N25Q_WaitWhileBusy(uint32_t timeout_loops)
+static bool n25q_read_sr(uint8_t *sr_out)
 {
-    while (timeout_loops-- != 0U)
+    return QSPI_HW_Read(N25Q_CMD_READ_STATUS_REGISTER, n25q_cmd_width(), sr_out, 1U);
+}
+
+bool N25Q_WaitWhileBusy(qspi_busy_op_t op)
+{
+    if ((uint32_t)op >= (uint32_t)QSPI_BUSY_OP_COUNT)
     {
-        if ((N25Q_ReadStatus() & N25Q_SR_WIP_Msk) == 0U)
-        {
-            return true;
-        }
+        return false;
     }
-    return false;
+    return QSPI_HW_WaitReady(n25q_read_sr, N25Q_SR_WIP_Msk, op, &n25q_timing[op]);
 }
 
 bool N25Q_ReadNVCR(uint16_t *nvcr_out)
@@ -109,7 +166,7 @@ bool N25Q_ReadNVCR(uint16_t *nvcr_out)
     }
 
     uint8_t buf[2] = { 0U, 0U };
-    if (!QSPI_HW_Read(N25Q_CMD_READ_NONVOLATILE_CFG, QSPI_WIDTH_SINGLE_BIT_SPI, buf, sizeof(buf)))
+    if (!QSPI_HW_Read(N25Q_CMD_READ_NONVOLATILE_CFG, n25q_cmd_width(), buf, sizeof(buf)))
     {
         return false;
     }
@@ -118,7 +175,7 @@ bool N25Q_ReadNVCR(uint16_t *nvcr_out)
     return true;
 }
 
-bool N25Q_WriteNVCR(uint16_t nvcr, uint32_t timeout_loops)
+bool N25Q_WriteNVCR(uint16_t nvcr)
 {
     uint8_t buf[2];
     buf[0] = (uint8_t)(nvcr & 0xFFU);
@@ -129,12 +186,12 @@ bool N25Q_WriteNVCR(uint16_t nvcr, uint32_t timeout_loops)
         return false;
     }
 
-    if (!QSPI_HW_Write(N25Q_CMD_WRITE_NONVOLATILE_CFG, QSPI_WIDTH_SINGLE_BIT_SPI, buf, sizeof(buf)))
+    if (!QSPI_HW_Write(N25Q_CMD_WRITE_NONVOLATILE_CFG, n25q_cmd_width(), buf, sizeof(buf)))
     {
         return false;
     }
 
-    return N25Q_WaitWhileBusy(timeout_loops);
+    return N25Q_WaitWhileBusy(QSPI_BUSY_REG_WRITE);
 }
 
 bool N25Q_ReadVCR(uint8_t *vcr_out)
@@ -143,25 +200,25 @@ bool N25Q_ReadVCR(uint8_t *vcr_out)
     {
         return false;
     }
-    return QSPI_HW_Read(N25Q_CMD_READ_VOLATILE_CFG, QSPI_WIDTH_SINGLE_BIT_SPI, vcr_out, 1U);
+    return QSPI_HW_Read(N25Q_CMD_READ_VOLATILE_CFG, n25q_cmd_width(), vcr_out, 1U);
 }
 
-bool N25Q_WriteVCR(uint8_t vcr, uint32_t timeout_loops)
+bool N25Q_WriteVCR(uint8_t vcr)
 {
     if (!N25Q_WriteEnable())
     {
         return false;
     }
 
-    if (!QSPI_HW_Write(N25Q_CMD_WRITE_VOLATILE_CFG, QSPI_WIDTH_SINGLE_BIT_SPI, &vcr, 1U))
+    if (!QSPI_HW_Write(N25Q_CMD_WRITE_VOLATILE_CFG, n25q_cmd_width(), &vcr, 1U))
     {
         return false;
     }
 
-    return N25Q_WaitWhileBusy(timeout_loops);
+    return N25Q_WaitWhileBusy(QSPI_BUSY_REG_WRITE);
 }
 
-bool N25Q_SetDummyCycles(uint8_t dummy_cycles, uint32_t timeout_loops)
+bool N25Q_SetDummyCycles(uint8_t dummy_cycles)
 {
     if (dummy_cycles > 15U)
     {
@@ -177,7 +234,7 @@ bool N25Q_SetDummyCycles(uint8_t dummy_cycles, uint32_t timeout_loops)
     vcr = (uint8_t)((vcr & (uint8_t)~N25Q_VCR_DUMMY_CYCLES_Msk) |
                     ((uint8_t)((dummy_cycles << N25Q_VCR_DUMMY_CYCLES_Pos) & N25Q_VCR_DUMMY_CYCLES_Msk)));
 
-    return N25Q_WriteVCR(vcr, timeout_loops);
+    return N25Q_WriteVCR(vcr);
 }
 
 bool N25Q_ReadEVCR(uint8_t *evcr_out)
@@ -186,25 +243,25 @@ bool N25Q_ReadEVCR(uint8_t *evcr_out)
     {
         return false;
     }
-    return QSPI_HW_Read(N25Q_CMD_READ_ENH_VOLATILE_CFG, QSPI_WIDTH_SINGLE_BIT_SPI, evcr_out, 1U);
+    return QSPI_HW_Read(N25Q_CMD_READ_ENH_VOLATILE_CFG, n25q_cmd_width(), evcr_out, 1U);
 }
 
-bool N25Q_WriteEVCR(uint8_t evcr, uint32_t timeout_loops)
+bool N25Q_WriteEVCR(uint8_t evcr)
 {
     if (!N25Q_WriteEnable())
     {
         return false;
     }
 
-    if (!QSPI_HW_Write(N25Q_CMD_WRITE_ENH_VOLATILE_CFG, QSPI_WIDTH_SINGLE_BIT_SPI, &evcr, 1U))
+    if (!QSPI_HW_Write(N25Q_CMD_WRITE_ENH_VOLATILE_CFG, n25q_cmd_width(), &evcr, 1U))
     {
         return false;
     }
 
-    return N25Q_WaitWhileBusy(timeout_loops);
+    return N25Q_WaitWhileBusy(QSPI_BUSY_REG_WRITE);
 }
 
-bool N25Q_EnableQuadIO(uint32_t timeout_loops)
+bool N25Q_EnableQuadIO(void)
 {
     /* Harmony app_n25q behavior:
      *   - WREN (single)
@@ -229,7 +286,7 @@ bool N25Q_EnableQuadIO(uint32_t timeout_loops)
         return false;
     }
 
-    if (!N25Q_WaitWhileBusy(timeout_loops))
+    if (!N25Q_WaitWhileBusy(QSPI_BUSY_REG_WRITE))
     {
         return false;
     }
@@ -240,36 +297,392 @@ bool N25Q_EnableQuadIO(uint32_t timeout_loops)
     return true;
 }
 
-bool N25Q_Enter4ByteAddressMode(uint32_t timeout_loops)
+bool N25Q_EnableXIP(void)
+{
+    uint8_t vcr = 0U;
+    if (!N25Q_ReadVCR(&vcr))
+    {
+        return false;
+    }
+
+    /* Volatile XIP: clear VCR bit3, the device then honours the confirmation bit */
+    vcr = (uint8_t)(vcr & (uint8_t)~N25Q_VCR_XIP_DISABLE_Msk);
+    return N25Q_WriteVCR(vcr);
+}
+
+bool N25Q_FastRead(void *rx, uint32_t len, uint32_t address)
+{
+    if ((rx == NULL) || (len == 0U))
+    {
+        return false;
+    }
+
+    uint32_t low = n25q_window_len(address, len);
+
+    /* Drive the XIP confirmation bit high (FFh) instead of leaving the bus
+     * floating, so a plain read can never enter XIP by accident. */
+    if ((low != 0U) &&
+        !QSPI_HW_MemoryRead(N25Q_CMD_FAST_READ,
+                            n25q_cmd_width(),
+                            n25q_addrlen(),
+                            true,
+                            N25Q_XIP_MODE_EXIT,
+                            (uint8_t)QSPI_INSTRFRAME_OPTCODELEN_8BITS_Val,
+                            N25Q_FAST_READ_DUMMY_CYCLES - 2U,
+                            rx,
+                            (size_t)low,
+                            address))
+    {
+        return false;
+    }
+
+    if (low == len)
+    {
+        return true;
+    }
+    return n25q_read_high((uint8_t *)rx + low, len - low, address + low);
+}
+
+bool N25Q_FastReadXIP(void *rx, uint32_t len, uint32_t address)
+{
+    if ((rx == NULL) || (len == 0U))
+    {
+        return false;
+    }
+
+    uint32_t low = n25q_window_len(address, len);
+    if (low == 0U)
+    {
+        /* XIP needs the AHB window; plain fast read above it */
+        return N25Q_FastRead(rx, len, address);
+    }
+
+    /* Option code clocks count toward the flash dummy cycles */
+    const qspi_cont_read_cfg_t cfg =
+    {
+        .opcode       = N25Q_CMD_FAST_READ,
+        .width        = n25q_cmd_width(),
+        .addrlen      = n25q_addrlen(),
+        .mode_enter   = N25Q_XIP_MODE_CONFIRM,
+        .mode_exit    = N25Q_XIP_MODE_EXIT,
+        .optlen       = (uint8_t)QSPI_INSTRFRAME_OPTCODELEN_8BITS_Val,
+        .dummy_cycles = N25Q_FAST_READ_DUMMY_CYCLES - 2U,
+    };
+
+    if (!QSPI_HW_MemoryRead_Continuous(&cfg, rx, (size_t)low, address))
+    {
+        return false;
+    }
+
+    if (low == len)
+    {
+        return true;
+    }
+    return N25Q_FastRead((uint8_t *)rx + low, len - low, address + low);
+}
+
+bool N25Q_PageProgram(const void *tx, uint32_t len, uint32_t address)
 {
+    if ((tx == NULL) || (len == 0U) || (len > N25Q_PAGE_SIZE))
+    {
+        return false;
+    }
+
+    /* A page never straddles 16 MB, so the window check covers all of it */
+    bool high = (address >= QSPI_HW_AHB_WINDOW_SIZE);
+    if (high && !s_addr4)
+    {
+        return false;
+    }
+
     if (!N25Q_WriteEnable())
     {
         return false;
     }
 
-    if (!QSPI_HW_Command(N25Q_CMD_ENTER_4BYTE_ADDR_MODE, n25q_cmd_width()))
+    if (high)
+    {
+        return QSPI_HW_WriteAddr(N25Q_CMD_PAGE_PROGRAM,
+                                 n25q_cmd_width(),
+                                 QSPI_ADDRLEN_32BITS,
+                                 address,
+                                 tx, (size_t)len);
+    }
+
+    return QSPI_HW_MemoryWrite(N25Q_CMD_PAGE_PROGRAM,
+                               n25q_cmd_width(),
+                               n25q_addrlen(),
+                               false, 0U, 0U,
+                               0U,
+                               tx, (size_t)len,
+                               address);
+}
+
+bool N25Q_SubsectorErase(uint32_t address)
+{
+    /* reject before WREN: a refused call must not leave WEL latched */
+    if ((address >= N25Q_3BYTE_ADDR_LIMIT) && !s_addr4)
     {
         return false;
     }
 
-    n25q_small_delay();
-    (void)timeout_loops;
+    if (!N25Q_WriteEnable())
+    {
+        return false;
+    }
+
+    return QSPI_HW_CommandAddr(N25Q_CMD_SUBSECTOR_ERASE,
+                               n25q_cmd_width(),
+                               n25q_addrlen(),
+                               address);
+}
+
+bool N25Q_SectorErase(uint32_t address)
+{
+    /* reject before WREN: a refused call must not leave WEL latched */
+    if ((address >= N25Q_3BYTE_ADDR_LIMIT) && !s_addr4)
+    {
+        return false;
+    }
+
+    if (!N25Q_WriteEnable())
+    {
+        return false;
+    }
+
+    return QSPI_HW_CommandAddr(N25Q_CMD_SECTOR_ERASE,
+                               n25q_cmd_width(),
+                               n25q_addrlen(),
+                               address);
+}
+
+bool N25Q_ReadFlagStatus(uint8_t *fsr_out)
+{
+    if (fsr_out == NULL)
+    {
+        return false;
+    }
+    return QSPI_HW_Read(N25Q_CMD_READ_FLAG_STATUS, n25q_cmd_width(), fsr_out, 1U);
+}
+
+/* Flag status with the ready bit inverted, so QSPI_HW_WaitReady() can wait on it */
+static bool n25q_read_fsr_busy(uint8_t *sr_out)
+{
+    if (!N25Q_ReadFlagStatus(sr_out))
+    {
+        return false;
+    }
+    *sr_out ^= N25Q_FSR_READY_Msk;
     return true;
 }
 
-bool N25Q_Exit4ByteAddressMode(uint32_t timeout_loops)
+bool N25Q_Suspend(void)
+{
+    uint8_t sr = 0U;
+
+    /* a failed status read must not pass for "nothing in progress" */
+    if (!n25q_read_sr(&sr))
+    {
+        return false;
+    }
+    if ((sr & N25Q_SR_WIP_Msk) == 0U)
+    {
+        return true;
+    }
+
+    if (!QSPI_HW_Command(N25Q_CMD_PROGRAM_ERASE_SUSPEND, n25q_cmd_width()))
+    {
+        return false;
+    }
+
+    /* Suspended = controller ready with a suspend flag set */
+    return QSPI_HW_WaitReady(n25q_read_fsr_busy, N25Q_FSR_READY_Msk,
+                             QSPI_BUSY_SUSPEND, &n25q_timing[QSPI_BUSY_SUSPEND]);
+}
+
+bool N25Q_Resume(void)
+{
+    uint8_t fsr = 0U;
+
+    if (!N25Q_ReadFlagStatus(&fsr))
+    {
+        return false;
+    }
+    if ((fsr & (N25Q_FSR_ERASE_SUSPEND_Msk | N25Q_FSR_PROGRAM_SUSPEND_Msk)) == 0U)
+    {
+        return true;
+    }
+
+    return QSPI_HW_Command(N25Q_CMD_PROGRAM_ERASE_RESUME, n25q_cmd_width());
+}
+
+bool N25Q_BulkEraseStart(void)
 {
     if (!N25Q_WriteEnable())
     {
         return false;
     }
 
-    if (!QSPI_HW_Command(N25Q_CMD_EXIT_4BYTE_ADDR_MODE, n25q_cmd_width()))
+    return QSPI_HW_Command(N25Q_CMD_BULK_ERASE, n25q_cmd_width());
+}
+
+bool N25Q_BulkErase(uint32_t timeout_ms)
+{
+    if (timeout_ms == 0U)
+    {
+        timeout_ms = N25Q_BULK_ERASE_TIMEOUT_MS;
+    }
+
+    if (!N25Q_BulkEraseStart())
     {
         return false;
     }
 
-    n25q_small_delay();
-    (void)timeout_loops;
+    const qspi_busy_timing_t t =
+    {
+        .typ_us = n25q_timing[QSPI_BUSY_CHIP_ERASE].typ_us,
+        .max_us = timeout_ms * 1000UL,
+    };
+    return QSPI_HW_WaitReady(n25q_read_sr, N25Q_SR_WIP_Msk, QSPI_BUSY_CHIP_ERASE, &t);
+}
+
+/* Switch the address mode and confirm it in the flag status register */
+static bool n25q_set_addr_mode(uint8_t opcode, bool addr4)
+{
+    if (!N25Q_WriteEnable())
+    {
+        return false;
+    }
+
+    if (!QSPI_HW_Command(opcode, n25q_cmd_width()))
+    {
+        return false;
+    }
+
+    uint8_t fsr = 0U;
+    if (!N25Q_ReadFlagStatus(&fsr) || (((fsr & N25Q_FSR_ADDR4_Msk) != 0U) != addr4))
+    {
+        return false;
+    }
+
+    s_addr4 = addr4;
+    return true;
+}
+
+bool N25Q_Enter4ByteAddressMode(void)
+{
+    return n25q_set_addr_mode(N25Q_CMD_ENTER_4BYTE_ADDR_MODE, true);
+}
+
+bool N25Q_Exit4ByteAddressMode(void)
+{
+    return n25q_set_addr_mode(N25Q_CMD_EXIT_4BYTE_ADDR_MODE, false);
+}
+
+bool N25Q_Is4ByteAddressMode(void)
+{
+    return s_addr4;
+}
+
+/* ---------------- qspi_flash_ops_t adaptors ---------------- */
+
+/* Reset, Harmony quad protocol switch, then in 4-4-4: VCR with the dummy
+ * cycles the fast read frames assume and volatile XIP enabled (needed by the
+ * continuous read path), and 4-byte addressing for the upper 16 MB. */
+static bool n25q_ops_init(void)
+{
+    if (!N25Q_Reset())
+    {
+        printf("[QSPI] N25Q_Reset failed\r\n");
+        return false;
+    }
+
+    if (!N25Q_EnableQuadIO())
+    {
+        printf("[QSPI] N25Q_EnableQuadIO failed\r\n");
+        return false;
+    }
+
+    uint8_t vcr = 0U;
+    if (!N25Q_ReadVCR(&vcr))
+    {
+        printf("[QSPI] N25Q_ReadVCR failed\r\n");
+        return false;
+    }
+    vcr = (uint8_t)((vcr & (uint8_t)~(N25Q_VCR_DUMMY_CYCLES_Msk | N25Q_VCR_XIP_DISABLE_Msk)) |
+                    (uint8_t)((N25Q_FAST_READ_DUMMY_CYCLES << N25Q_VCR_DUMMY_CYCLES_Pos) &
+                              N25Q_VCR_DUMMY_CYCLES_Msk));
+    if (!N25Q_WriteVCR(vcr))
+    {
+        printf("[QSPI] N25Q_WriteVCR failed\r\n");
+        return false;
+    }
+
+    if (!N25Q_Enter4ByteAddressMode())
+    {
+        printf("[QSPI] N25Q_Enter4ByteAddressMode failed\r\n");
+        return false;
+    }
     return true;
 }
+
+static bool n25q_ops_quad_enable(void)
+{
+    return N25Q_EnableQuadIO();
+}
+
+static bool n25q_ops_read_status(uint8_t *sr_out)
+{
+    if (sr_out == NULL)
+    {
+        return false;
+    }
+    /* not N25Q_ReadStatus(): a bus error must not read as WIP clear */
+    return n25q_read_sr(sr_out);
+}
+
+static bool n25q_ops_chip_erase(void)
+{
+    return N25Q_BulkErase(0U);
+}
+
+static uint32_t n25q_ops_block_fit(uint32_t address, uint32_t len)
+{
+    if (((address & (N25Q_SECTOR_SIZE - 1U)) != 0U) || (len < N25Q_SECTOR_SIZE))
+    {
+        return 0U;
+    }
+    return N25Q_SECTOR_SIZE;
+}
+
+static bool n25q_ops_erase_block(uint32_t address, uint32_t size)
+{
+    (void)size;
+    return N25Q_SectorErase(address);
+}
+
+const qspi_flash_ops_t g_n25q_flash_ops =
+{
+    .name               = "N25Q256A",
+    .jedec_id           = N25Q256A_JEDEC_ID,
+    .capacity           = N25Q_CAPACITY,
+    .sector_size        = N25Q_SUBSECTOR_SIZE,
+    .page_size          = N25Q_PAGE_SIZE,
+    .timing             = n25q_timing,
+
+    .init               = n25q_ops_init,
+    .quad_enable        = n25q_ops_quad_enable,
+    .read_jedec         = N25Q_ReadJEDEC,
+    .read_status        = n25q_ops_read_status,
+    .wait_ready         = N25Q_WaitWhileBusy,
+    .read               = N25Q_FastRead,
+    .read_cont          = N25Q_FastReadXIP,
+    .program            = N25Q_PageProgram,
+    .erase_sector       = N25Q_SubsectorErase,
+    .block_fit          = n25q_ops_block_fit,
+    .erase_block        = n25q_ops_erase_block,
+    .chip_erase         = n25q_ops_chip_erase,
+    .chip_erase_start   = N25Q_BulkEraseStart,
+    .suspend            = N25Q_Suspend,
+    .resume             = N25Q_Resume,
+};
@@ -7,6 +7,7 @@
 #include <stdbool.h>
 
 #include "../qspi_hw.h"
+#include "../qspi_flash_ops.h"
 
 /* --- Core commands --- */
 #define N25Q_CMD_WRITE_ENABLE             (0x06U)
@@ -31,17 +32,59 @@
 #define N25Q_CMD_READ_ENH_VOLATILE_CFG    (0x65U) /* RDVECR: returns 1 byte */
 #define N25Q_CMD_WRITE_ENH_VOLATILE_CFG   (0x61U) /* WRVECR: write 1 byte */
 
+/* --- Read --- */
+#define N25Q_CMD_FAST_READ                (0x0BU) /* quad protocol after EVCR quad enable */
+
+/* --- Program / erase --- */
+#define N25Q_CMD_PAGE_PROGRAM             (0x02U)
+#define N25Q_CMD_SUBSECTOR_ERASE          (0x20U) /* 4 KB */
+#define N25Q_CMD_SECTOR_ERASE             (0xD8U) /* 64 KB */
+#define N25Q_CMD_BULK_ERASE               (0xC7U)
+
+/* Program/erase suspend (subsector/sector erase and program, not bulk erase) */
+#define N25Q_CMD_PROGRAM_ERASE_SUSPEND    (0x75U)
+#define N25Q_CMD_PROGRAM_ERASE_RESUME     (0x7AU)
+#define N25Q_CMD_READ_FLAG_STATUS         (0x70U)
+
 /* --- Address mode --- */
 #define N25Q_CMD_ENTER_4BYTE_ADDR_MODE    (0xB7U)
 #define N25Q_CMD_EXIT_4BYTE_ADDR_MODE     (0xE9U)
 
+/* --- Geometry --- */
+#define N25Q256A_JEDEC_ID                 (0x0019BA20UL) /* 20h BAh 19h, byte0 first */
+#define N25Q_SUBSECTOR_SIZE               (4096U)
+#define N25Q_SECTOR_SIZE                  (0x10000UL)
+#define N25Q_PAGE_SIZE                    (256U)
+#define N25Q_3BYTE_ADDR_LIMIT             (16UL * 1024UL * 1024UL) /* 24-bit addressing */
+#define N25Q_CAPACITY                     (32UL * 1024UL * 1024UL) /* needs 4-byte mode */
+
+#ifndef N25Q_BULK_ERASE_TIMEOUT_MS
+#define N25Q_BULK_ERASE_TIMEOUT_MS        (480000UL)  /* datasheet max 480 s */
+#endif
+
 /* --- Status bits --- */
 #define N25Q_SR_WIP_Msk                   (1U << 0) /* Write-In-Progress */
 #define N25Q_SR_WEL_Msk                   (1U << 1) /* Write Enable Latch */
 
+/* Flag status register bits */
+#define N25Q_FSR_READY_Msk                (1U << 7) /* P/E controller ready */
+#define N25Q_FSR_ERASE_SUSPEND_Msk        (1U << 6)
+#define N25Q_FSR_PROGRAM_SUSPEND_Msk      (1U << 2)
+#define N25Q_FSR_ADDR4_Msk                (1U << 0) /* 4-byte address mode */
+
 /* --- VCR bitfields (Volatile Configuration Register) --- */
 #define N25Q_VCR_DUMMY_CYCLES_Pos         (4U)
 #define N25Q_VCR_DUMMY_CYCLES_Msk         (0xFU << N25Q_VCR_DUMMY_CYCLES_Pos)
+#define N25Q_VCR_XIP_DISABLE_Msk          (1U << 3) /* 0 = XIP enabled (volatile) */
+
+/* Dummy clocks for QIO fast read; written to VCR[7:4] at init (also the
+ * factory default, VCR dummy field = 0xF) */
+#define N25Q_FAST_READ_DUMMY_CYCLES       (10U)
+
+/* XIP confirmation bit = DQ0 during the first dummy clock.
+ * Sent as an 8-bit option code (2 clocks in 4-4-4): bit4 lands on DQ0. */
+#define N25Q_XIP_MODE_CONFIRM             (0x00U)
+#define N25Q_XIP_MODE_EXIT                (0xFFU)
 
 /* --- EVCR bitfields (Enhanced Volatile Configuration Register) --- */
 #define N25Q_EVCR_QUAD_DISABLE_Msk        (1U << 7)
@@ -54,20 +97,44 @@ bool N25Q_ReadJEDEC(uint32_t *jedec_out);
 
 bool N25Q_WriteEnable(void);
 uint8_t N25Q_ReadStatus(void);
-bool N25Q_WaitWhileBusy(uint32_t timeout_loops);
+/* Datasheet-timed wait for op (QSPI_HW_WaitReady with the N25Q timing) */
+bool N25Q_WaitWhileBusy(qspi_busy_op_t op);
 
 bool N25Q_ReadNVCR(uint16_t *nvcr_out);
-bool N25Q_WriteNVCR(uint16_t nvcr, uint32_t timeout_loops);
+bool N25Q_WriteNVCR(uint16_t nvcr);
 
 bool N25Q_ReadVCR(uint8_t *vcr_out);
-bool N25Q_WriteVCR(uint8_t vcr, uint32_t timeout_loops);
-bool N25Q_SetDummyCycles(uint8_t dummy_cycles, uint32_t timeout_loops);
+bool N25Q_WriteVCR(uint8_t vcr);
+bool N25Q_SetDummyCycles(uint8_t dummy_cycles);
 
 bool N25Q_ReadEVCR(uint8_t *evcr_out);
-bool N25Q_WriteEVCR(uint8_t evcr, uint32_t timeout_loops);
-bool N25Q_EnableQuadIO(uint32_t timeout_loops);
-
-bool N25Q_Enter4ByteAddressMode(uint32_t timeout_loops);
-bool N25Q_Exit4ByteAddressMode(uint32_t timeout_loops);
+bool N25Q_WriteEVCR(uint8_t evcr);
+bool N25Q_EnableQuadIO(void);
+
+bool N25Q_EnableXIP(void);
+bool N25Q_FastRead(void *rx, uint32_t len, uint32_t address);
+bool N25Q_FastReadXIP(void *rx, uint32_t len, uint32_t address);
+
+bool N25Q_PageProgram(const void *tx, uint32_t len, uint32_t address);
+bool N25Q_SubsectorErase(uint32_t address);
+bool N25Q_SectorErase(uint32_t address);    /* 64 KB */
+bool N25Q_BulkErase(uint32_t timeout_ms);
+/* WREN + bulk erase only (non-blocking callers poll the status register) */
+bool N25Q_BulkEraseStart(void);
+
+bool N25Q_ReadFlagStatus(uint8_t *fsr_out);
+/* Program/erase suspend: returns once the P/E controller is ready */
+bool N25Q_Suspend(void);
+bool N25Q_Resume(void);
+
+/* Address length follows the mode: 4-byte after Enter4ByteAddressMode().
+ * Above N25Q_3BYTE_ADDR_LIMIT (outside the 16 MB AHB window) reads and
+ * page programs go out as register-style frames. */
+bool N25Q_Enter4ByteAddressMode(void);
+bool N25Q_Exit4ByteAddressMode(void);
+bool N25Q_Is4ByteAddressMode(void);
+
+/* Runtime ops table (selected by JEDEC ID in QSPI_Flash_Init) */
+extern const qspi_flash_ops_t g_n25q_flash_ops;
 
 #endif /* N25Q256A_H */
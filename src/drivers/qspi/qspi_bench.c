@@ -0,0 +1,576 @@
+/* qspi_bench.c: QSPI throughput / latency benchmark matrix
+ *
+ * Tables printed by QSPI_Bench_Run():
+ *   1. Write   : sector erase and page program latency, program MB/s
+ *   2. Width   : 1-1-1, 1-1-2, 1-2-2, 1-1-4, 1-4-4 (flash in SPI protocol),
+ *                1-1-1 through the SPI-mode DMA path, 4-4-4 (SQI)
+ *   3. Dummy   : 4-4-4 read with the dummy count swept around the datasheet 6
+ *   4. BAUD    : 4-4-4 read per BAUD divider
+ *   5. Chunk   : call size vs per-call overhead, plain and continuous read
+ *   6. Copy    : CPU byte loop vs CPU word loop vs DMAC out of the AHB window
+ *   7. CRC32   : cycles/byte of the bitwise, slice-by-4 and slice-by-8 CRC,
+ *                the DSU engine and a DMAC copy + CRC (RAM buffer; runs
+ *                first and needs no flash)
+ *
+ * Every read is checked against the programmed pattern; "BAD" marks settings
+ * that are faster than the flash (or board) can follow.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "../../common/board.h"
+#include "../uart_dma.h"
+#include "qspi_bench.h"
+#include "qspi_flash.h"
+#include "qspi_hw.h"
+#include "qspi_spi_dma.h"
+#include "qspi_crc32.h"
+#include "qspi_crc_hw.h"
+#include "qspi_cache.h"
+
+/* ---------------- CRC32 (object store checksum) ---------------- */
+
+#define BENCH_CRC_BUF       (4096U)
+#define BENCH_CRC_REPS      (4U)
+
+typedef uint32_t (*bench_crc_fn_t)(uint32_t crc, const void *data, size_t len);
+
+__attribute__((aligned(4)))
+static uint8_t s_crc_buf[BENCH_CRC_BUF];
+
+#if QSPI_CRC_HW
+__attribute__((aligned(4)))
+static uint8_t s_crc_out[BENCH_CRC_BUF];
+
+static uint32_t bench_crc_dsu(uint32_t crc, const void *data, size_t len)
+{
+    (void)crc;
+    return QSPI_CRC_HW_Buffer(data, len);
+}
+
+/* Copy + CRC as the object read path does it, RAM to RAM */
+static uint32_t bench_crc_dmac(uint32_t crc, const void *data, size_t len)
+{
+    (void)crc;
+    QSPI_CRC_HW_CopyBegin();
+    QSPI_CRC_HW_Copy(s_crc_out, data, len);
+    return QSPI_CRC_HW_CopyEnd(NULL);
+}
+#endif
+
+/* Best of BENCH_CRC_REPS runs, so an interrupt does not skew the row */
+static uint32_t bench_crc_cycles(bench_crc_fn_t fn, uint32_t len, uint32_t *crc_out)
+{
+    uint32_t best = UINT32_MAX;
+
+    for (uint32_t i = 0; i < BENCH_CRC_REPS; i++)
+    {
+        uint32_t t0 = DWT->CYCCNT;
+        *crc_out = fn(0U, s_crc_buf, len);
+        uint32_t dt = DWT->CYCCNT - t0;
+        if (dt < best)
+            best = dt;
+    }
+    return best;
+}
+
+static void bench_crc_table(void)
+{
+    static const uint16_t lens[] = { 64U, 256U, 4096U };
+    static const struct { const char *name; bench_crc_fn_t fn; } impls[] =
+    {
+        { "bitwise",    QSPI_CRC32_Bitwise },
+#if QSPI_CRC32_SLICE >= 4
+        { "slice-by-4", QSPI_CRC32_Slice4 },
+#endif
+#if QSPI_CRC32_SLICE == 8
+        { "slice-by-8", QSPI_CRC32_Slice8 },
+#endif
+#if QSPI_CRC_HW
+        { "DSU",        bench_crc_dsu },
+        { "DMAC copy",  bench_crc_dmac },
+#endif
+    };
+
+    printf("\r\n[BENCH] CRC32 (tables in %s, QSPI_CRC32_SLICE=%u)\r\n",
+           QSPI_CRC32_TABLE_RAM ? "SRAM" : "flash", (unsigned)QSPI_CRC32_SLICE);
+
+    for (uint32_t i = 0; i < BENCH_CRC_BUF; i++)
+        s_crc_buf[i] = (uint8_t)((i * 0x9E3779B1UL) >> 24);
+
+    for (uint32_t l = 0; l < (sizeof(lens) / sizeof(lens[0])); l++)
+    {
+        uint32_t ref;
+        (void)bench_crc_cycles(QSPI_CRC32_Bitwise, lens[l], &ref);
+
+        for (uint32_t i = 0; i < (sizeof(impls) / sizeof(impls[0])); i++)
+        {
+            uint32_t crc;
+            uint32_t cyc = bench_crc_cycles(impls[i].fn, lens[l], &crc);
+            uint32_t cpb_x100 = (uint32_t)(((uint64_t)cyc * 100ULL) / lens[l]);
+            uint32_t mbps_x100 = (cyc != 0U)
+                ? (uint32_t)(((uint64_t)lens[l] * CPU_CLOCK_HZ * 100ULL) / ((uint64_t)cyc * 1000000ULL))
+                : 0U;
+
+            printf("  %-10s len=%-5u %4lu.%02lu cyc/B %4lu.%02lu MB/s  %s\r\n",
+                   impls[i].name, (unsigned)lens[l],
+                   (unsigned long)(cpb_x100 / 100U), (unsigned long)(cpb_x100 % 100U),
+                   (unsigned long)(mbps_x100 / 100U), (unsigned long)(mbps_x100 % 100U),
+                   (crc == ref) ? "OK" : "BAD");
+        }
+    }
+}
+
+#if APP_USE_SST26_FLASH
+#include "sst26/sst26.h"
+
+#define BENCH_CYC_PER_US    ((uint32_t)(CPU_CLOCK_HZ / 1000000UL))
+
+typedef struct
+{
+    const char   *name;
+    uint8_t       opcode;
+    qspi_width_t  width;
+    bool          mode_byte;    /* drive the mode byte (FFh: no continuous read) */
+    uint8_t       dummy;        /* dummy cycles after the mode byte */
+} bench_read_mode_t;
+
+typedef struct
+{
+    uint64_t cycles;
+    uint32_t ops;
+    uint32_t bytes;
+    bool     ok;
+} bench_result_t;
+
+__attribute__((aligned(4)))
+static uint8_t s_buf[QSPI_BENCH_MAX_CHUNK];
+
+static inline uint32_t bench_cyc(void)
+{
+    return DWT->CYCCNT;
+}
+
+/* Pattern byte depends only on the absolute address, so any chunking verifies */
+static inline uint8_t bench_pattern(uint32_t addr)
+{
+    uint32_t x = addr * 0x9E3779B1UL;
+    return (uint8_t)((x >> 24) ^ (x >> 13));
+}
+
+static bool bench_check(const uint8_t *buf, uint32_t len, uint32_t addr)
+{
+    for (uint32_t i = 0; i < len; i++)
+    {
+        if (buf[i] != bench_pattern(addr + i))
+            return false;
+    }
+    return true;
+}
+
+static void bench_print_row(const char *label, const bench_result_t *r)
+{
+    uint32_t mbps_x100 = 0U;
+    uint32_t us_x10 = 0U;
+
+    if ((r->cycles != 0U) && (r->ops != 0U))
+    {
+        mbps_x100 = (uint32_t)(((uint64_t)r->bytes * CPU_CLOCK_HZ * 100ULL) /
+                               (r->cycles * 1000000ULL));
+        us_x10 = (uint32_t)((r->cycles * 10ULL) / ((uint64_t)r->ops * BENCH_CYC_PER_US));
+    }
+
+    printf("  %-24s %4lu.%02lu MB/s %7lu.%01lu us/op  %s\r\n",
+           label,
+           (unsigned long)(mbps_x100 / 100U), (unsigned long)(mbps_x100 % 100U),
+           (unsigned long)(us_x10 / 10U), (unsigned long)(us_x10 % 10U),
+           r->ok ? "OK" : "BAD");
+}
+
+/* ---------------- copy routines (QSPI_HW_SetReadCopy) ---------------- */
+
+static void bench_copy_word(void *dst, const volatile void *src, size_t len)
+{
+    uint8_t *d8 = (uint8_t *)dst;
+    const volatile uint8_t *s8 = (const volatile uint8_t *)src;
+    size_t i = 0;
+
+    if ((((uintptr_t)dst | (uintptr_t)src) & 3U) == 0U)
+    {
+        uint32_t *d32 = (uint32_t *)dst;
+        const volatile uint32_t *s32 = (const volatile uint32_t *)src;
+        for (; (i + 4U) <= len; i += 4U)
+        {
+            *d32++ = *s32++;
+        }
+    }
+
+    for (; i < len; i++)
+    {
+        d8[i] = s8[i];
+    }
+}
+
+static void bench_dma_init(void)
+{
+    const uint8_t ch = QSPI_BENCH_DMA_CHANNEL;
+
+    DMAC_REGS->CHANNEL[ch].DMAC_CHCTRLA &= ~DMAC_CHCTRLA_ENABLE_Msk;
+    while ((DMAC_REGS->CHANNEL[ch].DMAC_CHCTRLA & DMAC_CHCTRLA_ENABLE_Msk) != 0U) { }
+
+    /* Software trigger, whole block per trigger, 4-beat bursts */
+    DMAC_REGS->CHANNEL[ch].DMAC_CHCTRLA =
+        DMAC_CHCTRLA_TRIGACT_TRANSACTION |
+        DMAC_CHCTRLA_TRIGSRC(0U) |
+        DMAC_CHCTRLA_BURSTLEN_4BEAT;
+    DMAC_REGS->CHANNEL[ch].DMAC_CHINTENCLR =
+        (DMAC_CHINTENCLR_TCMPL_Msk | DMAC_CHINTENCLR_TERR_Msk | DMAC_CHINTENCLR_SUSP_Msk);
+}
+
+/* Word DMAC copy, polled. Falls back to the word loop for odd sizes. */
+static void bench_copy_dma(void *dst, const volatile void *src, size_t len)
+{
+    const uint8_t ch = QSPI_BENCH_DMA_CHANNEL;
+    DmacDescriptor_t *d = DMA_GetDescriptor(ch);
+
+    if ((d == NULL) || ((((uintptr_t)dst | (uintptr_t)src | len) & 3U) != 0U))
+    {
+        bench_copy_word(dst, src, len);
+        return;
+    }
+
+    d->btctrl   = (uint16_t)(DMAC_BTCTRL_VALID_Msk |
+                             DMAC_BTCTRL_BEATSIZE_WORD |
+                             DMAC_BTCTRL_SRCINC_Msk |
+                             DMAC_BTCTRL_DSTINC_Msk |
+                             DMAC_BTCTRL_BLOCKACT_NOACT);
+    d->btcnt    = (uint16_t)(len / 4U);
+    d->srcaddr  = (uint32_t)(uintptr_t)src + (uint32_t)len;
+    d->dstaddr  = (uint32_t)(uintptr_t)dst + (uint32_t)len;
+    d->descaddr = 0U;
+
+    DMAC_REGS->CHANNEL[ch].DMAC_CHINTFLAG = (DMAC_CHINTFLAG_TCMPL_Msk | DMAC_CHINTFLAG_TERR_Msk);
+    DMAC_REGS->CHANNEL[ch].DMAC_CHCTRLA |= DMAC_CHCTRLA_ENABLE_Msk;
+    DMAC_REGS->DMAC_SWTRIGCTRL |= (1UL << ch);
+
+    while ((DMAC_REGS->CHANNEL[ch].DMAC_CHINTFLAG &
+            (DMAC_CHINTFLAG_TCMPL_Msk | DMAC_CHINTFLAG_TERR_Msk)) == 0U) { }
+}
+
+static const bench_read_mode_t s_spi_modes[] =
+{
+    /* SPI protocol (flash out of SQI) */
+    { "1-1-1 0Bh", SST26_CMD_HIGH_SPEED_READ, QSPI_WIDTH_SINGLE_BIT_SPI, false, SST26_SPI_READ_DUMMY_CYCLES },
+    { "1-1-2 3Bh", SST26_CMD_SDOR,            QSPI_WIDTH_DUAL_OUTPUT,    false, SST26_SPI_READ_DUMMY_CYCLES },
+    { "1-2-2 BBh", SST26_CMD_SDIOR,           QSPI_WIDTH_DUAL_IO,        true,  0U },
+    { "1-1-4 6Bh", SST26_CMD_SQOR,            QSPI_WIDTH_QUAD_OUTPUT,    false, SST26_SPI_READ_DUMMY_CYCLES },
+    { "1-4-4 EBh", SST26_CMD_SQIOR,           QSPI_WIDTH_QUAD_IO,        true,  SST26_SQIOR_DUMMY_CYCLES },
+};
+
+static const bench_read_mode_t s_sqi_mode =
+    { "4-4-4 0Bh", SST26_CMD_HIGH_SPEED_READ, QSPI_WIDTH_QUAD_CMD, true, SST26_HSREAD_DUMMY_CYCLES - 2U };
+
+static const qspi_cont_read_cfg_t s_sqi_cont_cfg =
+{
+    .opcode       = SST26_CMD_HIGH_SPEED_READ,
+    .width        = QSPI_WIDTH_QUAD_CMD,
+    .addrlen      = QSPI_ADDRLEN_24BITS,
+    .mode_enter   = SST26_HSREAD_MODE_CONTINUOUS,
+    .mode_exit    = SST26_HSREAD_MODE_EXIT,
+    .optlen       = (uint8_t)QSPI_INSTRFRAME_OPTCODELEN_8BITS_Val,
+    .dummy_cycles = SST26_HSREAD_DUMMY_CYCLES - 2U,
+};
+
+/* Read the whole scratch area in chunk-sized calls; only the read is timed */
+static void bench_read(const bench_read_mode_t *m, uint8_t dummy, uint32_t chunk,
+                       bool cont, bench_result_t *r)
+{
+    memset(r, 0, sizeof(*r));
+    r->ok = true;
+
+    for (uint32_t off = 0; off < QSPI_BENCH_SIZE; off += chunk)
+    {
+        uint32_t addr = QSPI_BENCH_ADDR + off;
+        bool ok;
+
+        uint32_t c0 = bench_cyc();
+        if (cont)
+        {
+            ok = QSPI_HW_MemoryRead_Continuous(&s_sqi_cont_cfg, s_buf, chunk, addr);
+        }
+        else
+        {
+            ok = QSPI_HW_MemoryRead(m->opcode, m->width, QSPI_ADDRLEN_24BITS,
+                                    m->mode_byte, SST26_HSREAD_MODE_EXIT,
+                                    (uint8_t)QSPI_INSTRFRAME_OPTCODELEN_8BITS_Val,
+                                    dummy, s_buf, chunk, addr);
+        }
+        r->cycles += (uint32_t)(bench_cyc() - c0);
+        r->ops++;
+        r->bytes += chunk;
+
+        if (!ok || !bench_check(s_buf, chunk, addr))
+            r->ok = false;
+    }
+
+    if (cont)
+        (void)QSPI_HW_ContinuousRead_Exit();
+}
+
+/* 0Bh in SPI mode through the DMAC (qspi_spi_dma.c): 1 byte opcode, 3 address, 1 dummy */
+static void bench_read_spi_dma(uint32_t chunk, bench_result_t *r)
+{
+    memset(r, 0, sizeof(*r));
+    r->ok = true;
+
+    for (uint32_t off = 0; off < QSPI_BENCH_SIZE; off += chunk)
+    {
+        uint32_t addr = QSPI_BENCH_ADDR + off;
+        uint8_t cmd[5] = { SST26_CMD_HIGH_SPEED_READ,
+                           (uint8_t)(addr >> 16), (uint8_t)(addr >> 8), (uint8_t)addr,
+                           0x00U };
+
+        uint32_t c0 = bench_cyc();
+        bool ok = QSPI_SPI_DMA_Transfer(cmd, sizeof(cmd), NULL, s_buf, (uint16_t)chunk, NULL) &&
+                  QSPI_SPI_DMA_Wait(100U);
+        r->cycles += (uint32_t)(bench_cyc() - c0);
+        r->ops++;
+        r->bytes += chunk;
+
+        if (!ok || !bench_check(s_buf, chunk, addr))
+            r->ok = false;
+    }
+}
+
+static bool bench_prepare_area(void)
+{
+    uint64_t erase_cyc = 0U, prog_cyc = 0U;
+    uint32_t erase_max = 0U, prog_max = 0U;
+    uint32_t sectors = QSPI_BENCH_SIZE / SST26_SECTOR_SIZE;
+    uint32_t pages = QSPI_BENCH_SIZE / SST26_PAGE_SIZE;
+
+    printf("\r\n[BENCH] Write (4-4-4, %lu sectors / %lu pages at 0x%06lX)\r\n",
+           (unsigned long)sectors, (unsigned long)pages, (unsigned long)QSPI_BENCH_ADDR);
+
+#if QSPI_CACHE_ENABLE
+    /* written behind the ops table, so the read cache has to forget it */
+    QSPI_Cache_Invalidate(QSPI_BENCH_ADDR, QSPI_BENCH_SIZE);
+#endif
+
+    for (uint32_t i = 0; i < sectors; i++)
+    {
+        uint32_t c0 = bench_cyc();
+        if (!SST26_SectorErase(QSPI_BENCH_ADDR + (i * SST26_SECTOR_SIZE)) ||
+            !SST26_WaitWhileBusy(QSPI_BUSY_SECTOR_ERASE))
+        {
+            printf("[BENCH] Sector erase FAILED\r\n");
+            return false;
+        }
+        uint32_t dc = bench_cyc() - c0;
+        erase_cyc += dc;
+        if (dc > erase_max) erase_max = dc;
+    }
+
+    for (uint32_t p = 0; p < pages; p++)
+    {
+        uint32_t addr = QSPI_BENCH_ADDR + (p * SST26_PAGE_SIZE);
+        for (uint32_t i = 0; i < SST26_PAGE_SIZE; i++)
+        {
+            s_buf[i] = bench_pattern(addr + i);
+        }
+
+        uint32_t c0 = bench_cyc();
+        if (!SST26_PageProgram(s_buf, SST26_PAGE_SIZE, addr) ||
+            !SST26_WaitWhileBusy(QSPI_BUSY_PAGE_PROG))
+        {
+            printf("[BENCH] Page program FAILED\r\n");
+            return false;
+        }
+        uint32_t dc = bench_cyc() - c0;
+        prog_cyc += dc;
+        if (dc > prog_max) prog_max = dc;
+    }
+
+    bench_result_t r = { prog_cyc, pages, QSPI_BENCH_SIZE, true };
+    printf("  Sector erase 4K         avg %lu us  max %lu us\r\n",
+           (unsigned long)(erase_cyc / sectors / BENCH_CYC_PER_US),
+           (unsigned long)(erase_max / BENCH_CYC_PER_US));
+    printf("  Page program 256B       avg %lu us  max %lu us\r\n",
+           (unsigned long)(prog_cyc / pages / BENCH_CYC_PER_US),
+           (unsigned long)(prog_max / BENCH_CYC_PER_US));
+    bench_print_row("Program (incl. busy)", &r);
+    return true;
+}
+
+static void bench_width_table(void)
+{
+    bench_result_t r;
+    uint8_t cr = 0U;
+    bool ioc_ok;
+
+    printf("\r\n[BENCH] Width (BAUD=%lu, chunk=%u, CPU byte copy)\r\n",
+           (unsigned long)((QSPI_REGS->QSPI_BAUD & QSPI_BAUD_BAUD_Msk) >> QSPI_BAUD_BAUD_Pos),
+           QSPI_BENCH_MAX_CHUNK);
+
+    /* Quad-output SPI reads need IOC=1 (WP#/HOLD# used as SIO2/SIO3) */
+    ioc_ok = SST26_ReadConfig(&cr) && SST26_WriteConfig((uint8_t)(cr | SST26_CR_IOC_Msk));
+
+    if (!SST26_DisableQuadIO())
+    {
+        printf("  SPI protocol switch FAILED, skipping 1-x-x rows\r\n");
+    }
+    else
+    {
+        for (uint32_t i = 0; i < (sizeof(s_spi_modes) / sizeof(s_spi_modes[0])); i++)
+        {
+            bench_read(&s_spi_modes[i], s_spi_modes[i].dummy, QSPI_BENCH_MAX_CHUNK, false, &r);
+            bench_print_row(s_spi_modes[i].name, &r);
+        }
+
+        bench_read_spi_dma(QSPI_BENCH_MAX_CHUNK, &r);
+        bench_print_row("1-1-1 0Bh SPI-mode DMA", &r);
+
+        printf("  %-24s n/a (SST26 has no dual command protocol)\r\n", "2-2-2");
+
+        (void)SST26_EnableQuadIO();
+    }
+
+    if (ioc_ok)
+    {
+        (void)SST26_WriteConfig(cr);
+    }
+
+    bench_read(&s_sqi_mode, s_sqi_mode.dummy, QSPI_BENCH_MAX_CHUNK, false, &r);
+    bench_print_row(s_sqi_mode.name, &r);
+}
+
+static void bench_dummy_table(void)
+{
+    static const uint8_t dummies[] = { 4U, 6U, 8U, 10U };
+    bench_result_t r;
+    char label[32];
+
+    printf("\r\n[BENCH] Dummy cycles (4-4-4 0Bh, no mode byte; datasheet = %u)\r\n",
+           SST26_HSREAD_DUMMY_CYCLES);
+
+    bench_read_mode_t m = s_sqi_mode;
+    m.mode_byte = false;
+
+    for (uint32_t i = 0; i < sizeof(dummies); i++)
+    {
+        bench_read(&m, dummies[i], QSPI_BENCH_MAX_CHUNK, false, &r);
+        snprintf(label, sizeof(label), "dummy=%u", dummies[i]);
+        bench_print_row(label, &r);
+    }
+}
+
+static void bench_baud_table(uint8_t baud_restore)
+{
+    static const uint8_t bauds[] = { 0U, 1U, 2U, 3U, 5U, 7U };
+    bench_result_t r;
+    char label[32];
+
+    printf("\r\n[BENCH] BAUD (4-4-4, chunk=%u)\r\n", QSPI_BENCH_MAX_CHUNK);
+
+    for (uint32_t i = 0; i < sizeof(bauds); i++)
+    {
+        /* same SCK estimate as QSPI_Flash_Diag_Print() */
+        uint32_t f_sck = (uint32_t)CPU_CLOCK_HZ / (2UL * ((uint32_t)bauds[i] + 1UL));
+
+        QSPI_HW_SetBaud(bauds[i]);
+        bench_read(&s_sqi_mode, s_sqi_mode.dummy, QSPI_BENCH_MAX_CHUNK, false, &r);
+        snprintf(label, sizeof(label), "BAUD=%u (~%lu MHz)", bauds[i],
+                 (unsigned long)(f_sck / 1000000UL));
+        bench_print_row(label, &r);
+    }
+
+    QSPI_HW_SetBaud(baud_restore);
+}
+
+static void bench_chunk_table(void)
+{
+    static const uint16_t chunks[] = { 16U, 64U, 256U, 1024U, 4096U };
+    bench_result_t r;
+    char label[32];
+
+    printf("\r\n[BENCH] Chunk size (4-4-4, plain vs continuous read)\r\n");
+
+    for (uint32_t i = 0; i < (sizeof(chunks) / sizeof(chunks[0])); i++)
+    {
+        bench_read(&s_sqi_mode, s_sqi_mode.dummy, chunks[i], false, &r);
+        snprintf(label, sizeof(label), "chunk=%u", chunks[i]);
+        bench_print_row(label, &r);
+
+        bench_read(&s_sqi_mode, s_sqi_mode.dummy, chunks[i], true, &r);
+        snprintf(label, sizeof(label), "chunk=%u continuous", chunks[i]);
+        bench_print_row(label, &r);
+    }
+}
+
+static void bench_copy_table(void)
+{
+    static const uint16_t chunks[] = { 256U, 4096U };
+    static const struct { const char *name; qspi_read_copy_t fn; } copies[] =
+    {
+        { "CPU byte", NULL },
+        { "CPU word", bench_copy_word },
+        { "DMAC",     bench_copy_dma },
+    };
+    bench_result_t r;
+    char label[32];
+
+    printf("\r\n[BENCH] AHB copy (4-4-4)\r\n");
+
+    bench_dma_init();
+
+    for (uint32_t c = 0; c < (sizeof(chunks) / sizeof(chunks[0])); c++)
+    {
+        for (uint32_t i = 0; i < (sizeof(copies) / sizeof(copies[0])); i++)
+        {
+            QSPI_HW_SetReadCopy(copies[i].fn);
+            bench_read(&s_sqi_mode, s_sqi_mode.dummy, chunks[c], false, &r);
+            snprintf(label, sizeof(label), "%s chunk=%u", copies[i].name, chunks[c]);
+            bench_print_row(label, &r);
+        }
+    }
+
+    QSPI_HW_SetReadCopy(NULL);
+}
+
+void QSPI_Bench_Run(void)
+{
+    uint8_t baud = (uint8_t)((QSPI_REGS->QSPI_BAUD & QSPI_BAUD_BAUD_Msk) >> QSPI_BAUD_BAUD_Pos);
+
+    printf("\r\n=============== QSPI BENCHMARK ===============\r\n");
+
+    bench_crc_table();
+
+    /* Width/dummy tables use SST26 opcodes and protocol switches */
+    const qspi_flash_ops_t *ops = QSPI_Flash_Ops();
+    if ((ops == NULL) || (ops->jedec_id != SST26VF064B_JEDEC_ID) || !SST26_IsQuadIO())
+    {
+        printf("[BENCH] SST26 in SQI mode required\r\n");
+        return;
+    }
+
+    if (!bench_prepare_area())
+        return;
+
+    bench_width_table();
+    bench_dummy_table();
+    bench_baud_table(baud);
+    bench_chunk_table();
+    bench_copy_table();
+
+    printf("===============================================\r\n");
+}
+
+#else /* !APP_USE_SST26_FLASH */
+
+void QSPI_Bench_Run(void)
+{
+    bench_crc_table();
+    printf("[BENCH] SST26 driver not built in\r\n");
+}
+
+#endif
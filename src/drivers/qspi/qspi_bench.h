@@ -0,0 +1,30 @@
+/* qspi_bench.h: QSPI throughput / latency benchmark matrix
+ *
+ * Measures read MB/s and per-call latency across bus widths (1-1-1 .. 4-4-4),
+ * dummy cycles, BAUD values, chunk sizes and CPU vs DMAC copy out of the AHB
+ * window, plus sector erase / page program timing. Results are printed as
+ * tables over the UART. All timing uses DWT->CYCCNT.
+ *
+ * The scratch region below is ERASED and rewritten on every run.
+ */
+
+#ifndef QSPI_BENCH_H
+#define QSPI_BENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Scratch area: 64 KB just below the SST26 top 32K/8K parameter blocks */
+#define QSPI_BENCH_ADDR         (0x7E0000UL)
+#define QSPI_BENCH_SIZE         (0x10000UL)
+
+/* Largest chunk measured (also the size of the static read buffer) */
+#define QSPI_BENCH_MAX_CHUNK    (4096U)
+
+/* DMAC channel used for the memory-to-memory copy rows (software trigger) */
+#define QSPI_BENCH_DMA_CHANNEL  3
+
+/* Run every table. Leaves BAUD, read copy routine and SQI mode as found. */
+void QSPI_Bench_Run(void);
+
+#endif /* QSPI_BENCH_H */
@@ -0,0 +1,345 @@
+/* qspi_cache.c: Set-associative SRAM cache for flash reads */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include "qspi_cache.h"
+#include "qspi_hw.h"
+
+#if QSPI_CACHE_ENABLE
+
+#if ((QSPI_CACHE_LINE & (QSPI_CACHE_LINE - 1)) != 0) || ((QSPI_CACHE_SETS & (QSPI_CACHE_SETS - 1)) != 0)
+#error "QSPI_CACHE_LINE and QSPI_CACHE_SETS must be powers of two"
+#endif
+
+#define CACHE_TAG_EMPTY     (0xFFFFFFFFUL)
+#define CACHE_SR_WIP_Msk    (0x01U)         /* bit0 on every supported part */
+
+__attribute__((aligned(4)))
+static uint8_t  s_data[QSPI_CACHE_SETS][QSPI_CACHE_WAYS][QSPI_CACHE_LINE];
+static uint32_t s_tag[QSPI_CACHE_SETS][QSPI_CACHE_WAYS];     /* line address */
+static uint32_t s_used[QSPI_CACHE_SETS][QSPI_CACHE_WAYS];    /* s_clock at last use */
+static uint32_t s_clock;
+
+/* Driver entries the wrappers forward to */
+static qspi_flash_ops_t s_dev;
+static bool             s_attached;
+
+/* Program/erase issued and not yet seen finished */
+static uint32_t s_busy_addr;
+static uint32_t s_busy_len;
+static bool     s_suspended;
+
+static qspi_cache_stats_t s_stats;
+
+static inline uint32_t cache_set(uint32_t line)
+{
+    return (line / QSPI_CACHE_LINE) & (QSPI_CACHE_SETS - 1U);
+}
+
+static inline bool cache_busy_overlaps(uint32_t addr, uint32_t len)
+{
+    return (s_busy_len != 0U) &&
+           (addr < (s_busy_addr + s_busy_len)) && (s_busy_addr < (addr + len));
+}
+
+static uint32_t cache_lookup(uint32_t set, uint32_t line)
+{
+    for (uint32_t w = 0; w < QSPI_CACHE_WAYS; w++)
+    {
+        if (s_tag[set][w] == line)
+            return w;
+    }
+    return QSPI_CACHE_WAYS;
+}
+
+/* Empty way first, else the least recently used one */
+static uint32_t cache_victim(uint32_t set)
+{
+    uint32_t victim = 0U;
+    uint32_t oldest = 0U;
+
+    for (uint32_t w = 0; w < QSPI_CACHE_WAYS; w++)
+    {
+        if (s_tag[set][w] == CACHE_TAG_EMPTY)
+            return w;
+
+        uint32_t age = s_clock - s_used[set][w];
+        if (age > oldest)
+        {
+            oldest = age;
+            victim = w;
+        }
+    }
+    return victim;
+}
+
+/*
+ * The installed read copy routine may be a DMAC copy + CRC session
+ * (QSPI_CRC_HW_CopyBegin) that expects to see exactly the bytes the caller
+ * asked for: line fills run with the default copy, and what is handed to
+ * the caller goes through the session's routine, hit or miss.
+ */
+static bool cache_read(bool (*dev_read)(void *rx, uint32_t len, uint32_t address),
+                       void *rx, uint32_t len, uint32_t address)
+{
+    uint8_t *out = (uint8_t *)rx;
+    qspi_read_copy_t copy = QSPI_HW_GetReadCopy();
+
+    if ((rx == NULL) || (len == 0U))
+        return false;
+
+    /* Nothing is ever dirty here, so the flash is always current */
+    if ((QSPI_CACHE_BYPASS_LEN != 0U) && (len >= QSPI_CACHE_BYPASS_LEN))
+    {
+        s_stats.bypass++;
+        return dev_read(rx, len, address);
+    }
+
+    while (len)
+    {
+        uint32_t line = address & ~(QSPI_CACHE_LINE - 1U);
+        uint32_t off  = address - line;
+        uint32_t n    = QSPI_CACHE_LINE - off;
+        uint32_t set  = cache_set(line);
+        uint32_t way  = cache_lookup(set, line);
+
+        if (n > len)
+            n = len;
+
+        if (way < QSPI_CACHE_WAYS)
+        {
+            s_stats.hits++;
+        }
+        else if (cache_busy_overlaps(line, QSPI_CACHE_LINE))
+        {
+            /* Being programmed/erased: what the flash returns now is not kept */
+            s_stats.misses++;
+            s_stats.bypass++;
+            if (!dev_read(out, n, address))
+                return false;
+            address += n;
+            out     += n;
+            len     -= n;
+            continue;
+        }
+        else
+        {
+            s_stats.misses++;
+            way = cache_victim(set);
+            if (s_tag[set][way] != CACHE_TAG_EMPTY)
+                s_stats.evictions++;
+
+            s_tag[set][way] = CACHE_TAG_EMPTY;
+            QSPI_HW_SetReadCopy(NULL);
+            bool ok = dev_read(s_data[set][way], QSPI_CACHE_LINE, line);
+            QSPI_HW_SetReadCopy(copy);
+            if (!ok)
+                return false;
+            s_tag[set][way] = line;
+            s_stats.fills++;
+        }
+
+        s_used[set][way] = ++s_clock;
+        if (copy != NULL)
+            copy(out, &s_data[set][way][off], n);
+        else
+            memcpy(out, &s_data[set][way][off], n);
+
+        address += n;
+        out     += n;
+        len     -= n;
+    }
+    return true;
+}
+
+/* ---------------- qspi_flash_ops_t wrappers ---------------- */
+
+static bool cache_ops_read(void *rx, uint32_t len, uint32_t address)
+{
+    return cache_read(s_dev.read, rx, len, address);
+}
+
+static bool cache_ops_read_cont(void *rx, uint32_t len, uint32_t address)
+{
+    return cache_read(s_dev.read_cont, rx, len, address);
+}
+
+static void cache_write_issue(uint32_t addr, uint32_t len)
+{
+    QSPI_Cache_Invalidate(addr, len);
+    s_busy_addr = addr;
+    s_busy_len  = len;
+}
+
+static bool cache_ops_program(const void *tx, uint32_t len, uint32_t address)
+{
+    cache_write_issue(address, len);
+    return s_dev.program(tx, len, address);
+}
+
+static bool cache_ops_erase_sector(uint32_t address)
+{
+    cache_write_issue(address, s_dev.sector_size);
+    return s_dev.erase_sector(address);
+}
+
+static bool cache_ops_erase_block(uint32_t address, uint32_t size)
+{
+    cache_write_issue(address, size);
+    return s_dev.erase_block(address, size);
+}
+
+static bool cache_ops_chip_erase(void)
+{
+    QSPI_Cache_Flush();
+    s_busy_addr = 0U;
+    s_busy_len  = s_dev.capacity;
+
+    bool ok = s_dev.chip_erase();
+    if (ok)
+        s_busy_len = 0U;        /* blocking: done */
+    return ok;
+}
+
+static bool cache_ops_chip_erase_start(void)
+{
+    QSPI_Cache_Flush();
+    s_busy_addr = 0U;
+    s_busy_len  = s_dev.capacity;
+    return s_dev.chip_erase_start();
+}
+
+/* A suspended operation also reads WIP clear: only count it done when not */
+static bool cache_ops_read_status(uint8_t *sr_out)
+{
+    bool ok = s_dev.read_status(sr_out);
+
+    if (ok && !s_suspended && ((*sr_out & CACHE_SR_WIP_Msk) == 0U))
+        s_busy_len = 0U;
+    return ok;
+}
+
+static bool cache_ops_wait_ready(qspi_busy_op_t op)
+{
+    bool ok = s_dev.wait_ready(op);
+
+    if (ok && !s_suspended)
+        s_busy_len = 0U;
+    return ok;
+}
+
+static bool cache_ops_suspend(void)
+{
+    bool ok = s_dev.suspend();
+
+    if (ok)
+        s_suspended = true;
+    return ok;
+}
+
+static bool cache_ops_resume(void)
+{
+    s_suspended = false;
+    return s_dev.resume();
+}
+
+/* ---------------- API ---------------- */
+
+void QSPI_Cache_Attach(qspi_flash_ops_t *ops)
+{
+    s_dev       = *ops;
+    s_busy_len  = 0U;
+    s_suspended = false;
+    QSPI_Cache_Flush();
+    QSPI_Cache_ResetStats();
+
+    ops->read         = cache_ops_read;
+    ops->program      = cache_ops_program;
+    ops->erase_sector = cache_ops_erase_sector;
+    ops->read_status  = cache_ops_read_status;
+    ops->wait_ready   = cache_ops_wait_ready;
+    if (ops->read_cont != NULL)
+        ops->read_cont = cache_ops_read_cont;
+    if (ops->erase_block != NULL)
+        ops->erase_block = cache_ops_erase_block;
+    if (ops->chip_erase != NULL)
+        ops->chip_erase = cache_ops_chip_erase;
+    if (ops->chip_erase_start != NULL)
+        ops->chip_erase_start = cache_ops_chip_erase_start;
+    if (ops->suspend != NULL)
+        ops->suspend = cache_ops_suspend;
+    if (ops->resume != NULL)
+        ops->resume = cache_ops_resume;
+
+    s_attached = true;
+}
+
+/* SETS x WAYS tags: cheaper to check them all than to walk the range by line */
+void QSPI_Cache_Invalidate(uint32_t addr, uint32_t len)
+{
+    if (len == 0U)
+        return;
+
+    for (uint32_t s = 0; s < QSPI_CACHE_SETS; s++)
+    {
+        for (uint32_t w = 0; w < QSPI_CACHE_WAYS; w++)
+        {
+            uint32_t line = s_tag[s][w];
+            if ((line != CACHE_TAG_EMPTY) &&
+                (line < (addr + len)) && (addr < (line + QSPI_CACHE_LINE)))
+            {
+                s_tag[s][w] = CACHE_TAG_EMPTY;
+                s_stats.invalidated++;
+            }
+        }
+    }
+}
+
+void QSPI_Cache_Flush(void)
+{
+    for (uint32_t s = 0; s < QSPI_CACHE_SETS; s++)
+    {
+        for (uint32_t w = 0; w < QSPI_CACHE_WAYS; w++)
+            s_tag[s][w] = CACHE_TAG_EMPTY;
+    }
+    s_stats.flushes++;
+}
+
+bool QSPI_Cache_ReadThrough(void *rx, uint32_t len, uint32_t address)
+{
+    return s_attached && s_dev.read(rx, len, address);
+}
+
+void QSPI_Cache_GetStats(qspi_cache_stats_t *out)
+{
+    if (out != NULL)
+        *out = s_stats;
+}
+
+void QSPI_Cache_ResetStats(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+}
+
+void QSPI_Cache_Print(void)
+{
+    uint32_t lookups = s_stats.hits + s_stats.misses;
+    uint32_t permille = (lookups != 0U) ?
+                        (uint32_t)(((uint64_t)s_stats.hits * 1000U) / lookups) : 0U;
+
+    printf("---- Read cache ----\r\n");
+    printf("  Geometry      : %u sets x %u ways x %u B (%lu KB)%s\r\n",
+           (unsigned)QSPI_CACHE_SETS, (unsigned)QSPI_CACHE_WAYS, (unsigned)QSPI_CACHE_LINE,
+           (unsigned long)((QSPI_CACHE_SETS * QSPI_CACHE_WAYS * QSPI_CACHE_LINE) / 1024U),
+           s_attached ? "" : ", not attached");
+    printf("  Lines         : %lu hits, %lu misses (%lu.%lu%% hit), %lu fills, %lu evictions\r\n",
+           (unsigned long)s_stats.hits, (unsigned long)s_stats.misses,
+           (unsigned long)(permille / 10U), (unsigned long)(permille % 10U),
+           (unsigned long)s_stats.fills, (unsigned long)s_stats.evictions);
+    printf("  Coherency     : %lu lines invalidated, %lu flushes, %lu reads passed through\r\n",
+           (unsigned long)s_stats.invalidated, (unsigned long)s_stats.flushes,
+           (unsigned long)s_stats.bypass);
+}
+
+#endif /* QSPI_CACHE_ENABLE */
@@ -0,0 +1,88 @@
+/* qspi_cache.h: Set-associative SRAM cache for flash reads
+ *
+ * Object headers, config payloads and log metadata are read again and again,
+ * and every read is a full QSPI instruction (opcode, address, mode, dummy)
+ * even for 32 bytes. The cache keeps recently read lines in SRAM so repeated
+ * reads of the same area do not touch the bus at all.
+ *
+ * QSPI_Flash_Init() attaches it to the runtime ops table: read/read_cont
+ * (SST26_HighSpeedRead and friends) go through the cache, and program, erase
+ * and status entries are wrapped so coherency is kept where the flash
+ * changes. Everything that uses QSPI_Flash_Ops() (job engine, log store,
+ * wear counters) is covered without changes. The job engine's blank-check
+ * and verify sweeps read through QSPI_Cache_ReadThrough() so they do not
+ * evict the hot lines.
+ *
+ *   QSPI_CACHE_SETS sets x QSPI_CACHE_WAYS ways x QSPI_CACHE_LINE bytes,
+ *   set = (address / LINE) % SETS, LRU replacement within a set
+ *
+ * Coherency: a program or erase drops the lines it overlaps when it is
+ * issued, and until the flash reports it finished (WIP clear, not suspended)
+ * misses in that range are read straight through instead of filling a line
+ * with half-programmed data. A chip erase drops everything.
+ *
+ * Writes issued straight through a driver bypass the ops table: the SST26
+ * full-chip test and image programming invalidate their range themselves,
+ * anything else (benchmark) calls QSPI_Cache_Invalidate() after it. Reads
+ * through the AHB window (object views, XIP) are not cached.
+ */
+
+#ifndef QSPI_CACHE_H
+#define QSPI_CACHE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "qspi_flash_ops.h"
+
+/* 1 = cache flash reads in SRAM (SETS * WAYS * LINE bytes) */
+#ifndef QSPI_CACHE_ENABLE
+#define QSPI_CACHE_ENABLE       1
+#endif
+
+/* Line: one QSPI read on a miss (power of two, up to 4 KB so a line never
+ * straddles a scramble boundary). Sets: power of two. Default 16 x 4 x 128 B
+ * = 8 KB. */
+#ifndef QSPI_CACHE_LINE
+#define QSPI_CACHE_LINE         (128U)
+#endif
+#ifndef QSPI_CACHE_WAYS
+#define QSPI_CACHE_WAYS         (4U)
+#endif
+#ifndef QSPI_CACHE_SETS
+#define QSPI_CACHE_SETS         (16U)
+#endif
+
+/* Reads of this many bytes or more are passed through without filling, so a
+ * bulk copy does not evict the hot lines (0 = cache every read) */
+#ifndef QSPI_CACHE_BYPASS_LEN
+#define QSPI_CACHE_BYPASS_LEN   (1024U)
+#endif
+
+typedef struct
+{
+    uint32_t hits;                  /* lines served from SRAM */
+    uint32_t misses;                /* lines read from flash */
+    uint32_t fills;                 /* of those, kept in a line */
+    uint32_t bypass;                /* reads passed through (bulk or busy range) */
+    uint32_t evictions;
+    uint32_t invalidated;           /* lines dropped by program/erase */
+    uint32_t flushes;               /* whole cache dropped */
+} qspi_cache_stats_t;
+
+/* Route ops' reads through the cache and wrap its program/erase/status
+ * entries (ops is the runtime copy, not a const driver table) */
+void QSPI_Cache_Attach(qspi_flash_ops_t *ops);
+
+/* Drop cached lines overlapping [addr, addr + len) */
+void QSPI_Cache_Invalidate(uint32_t addr, uint32_t len);
+void QSPI_Cache_Flush(void);
+
+/* Driver read that skips the cache (false if not attached) */
+bool QSPI_Cache_ReadThrough(void *rx, uint32_t len, uint32_t address);
+
+void QSPI_Cache_GetStats(qspi_cache_stats_t *out);
+void QSPI_Cache_ResetStats(void);
+void QSPI_Cache_Print(void);
+
+#endif /* QSPI_CACHE_H */
@@ -0,0 +1,56 @@
+/* qspi_crc32.h: CRC-32 (IEEE 802.3, reflected 0xEDB88320) for the object store
+ *
+ * Same polynomial, init and final XOR as the original bit-by-bit routine, so
+ * objects and wear metadata written by older firmware still verify.
+ *
+ *   QSPI_CRC32_SLICE 1 : bitwise, 8 shift/xor steps per byte, no table
+ *   QSPI_CRC32_SLICE 4 : slice-by-4, one 32-bit load + 4 lookups per 4 bytes
+ *                        (4 KB of tables)
+ *   QSPI_CRC32_SLICE 8 : slice-by-8, 8 lookups per 8 bytes (8 KB of tables)
+ *
+ * Tables are const (flash, served through the CMCC) unless
+ * QSPI_CRC32_TABLE_RAM is 1: then QSPI_CRC32_Init() builds them in SRAM
+ * (zero wait state, no cache misses, costs the SRAM).
+ */
+
+#ifndef QSPI_CRC32_H
+#define QSPI_CRC32_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifndef QSPI_CRC32_SLICE
+#define QSPI_CRC32_SLICE        8
+#endif
+
+#ifndef QSPI_CRC32_TABLE_RAM
+#define QSPI_CRC32_TABLE_RAM    0
+#endif
+
+#if (QSPI_CRC32_SLICE != 1) && (QSPI_CRC32_SLICE != 4) && (QSPI_CRC32_SLICE != 8)
+#error "QSPI_CRC32_SLICE must be 1, 4 or 8"
+#endif
+
+/* CRC of "123456789" */
+#define QSPI_CRC32_CHECK        (0xCBF43926UL)
+
+/* Builds the SRAM tables (if configured) and checks QSPI_CRC32_CHECK */
+bool QSPI_CRC32_Init(void);
+
+/* One-shot CRC of a buffer */
+uint32_t QSPI_CRC32(const void *data, size_t len);
+
+/* Continue a CRC: crc is the result of the previous call (0 to start) */
+uint32_t QSPI_CRC32_Update(uint32_t crc, const void *data, size_t len);
+
+/* Individual implementations, for the benchmark (same results) */
+uint32_t QSPI_CRC32_Bitwise(uint32_t crc, const void *data, size_t len);
+#if QSPI_CRC32_SLICE >= 4
+uint32_t QSPI_CRC32_Slice4(uint32_t crc, const void *data, size_t len);
+#endif
+#if QSPI_CRC32_SLICE == 8
+uint32_t QSPI_CRC32_Slice8(uint32_t crc, const void *data, size_t len);
+#endif
+
+#endif /* QSPI_CRC32_H */
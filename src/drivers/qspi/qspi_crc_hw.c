@@ -0,0 +1,367 @@
+/* qspi_crc_hw.c: CRC-32 offload to the DMAC CRC unit and the DSU */
+
+#include <stdio.h>
+#include <string.h>
+#include "../../common/board.h"
+#include "../uart_dma.h"
+#include "qspi_crc_hw.h"
+#include "qspi_crc32.h"
+#include "qspi_hw.h"
+
+#if QSPI_CRC_HW
+
+/* Engine register <-> CRC value: optional bit reversal and complement.
+ * Both are involutions and commute, so one function converts either way. */
+#define CRC_HW_FORM_REV     (1U << 0)
+#define CRC_HW_FORM_INV     (1U << 1)
+#define CRC_HW_FORMS        (4U)
+
+/* Per engine run; the DSU/DMAC move ~4 bytes per bus cycle, so this is far
+ * above any legitimate run and only catches a stuck engine */
+#define CRC_HW_TIMEOUT_CYC  ((uint32_t)(CPU_CLOCK_HZ / 100UL))     /* 10 ms */
+
+/* Largest DMAC block: BTCNT is 16 bits of word beats */
+#define CRC_HW_DMA_MAX_WORDS (0xFFFFU)
+
+typedef bool (*crc_hw_run_t)(uint32_t *reg, void *dst, const volatile void *src, uint32_t words);
+
+static qspi_crc_hw_stats_t s_stats;
+static uint8_t  s_dsu_form;
+static uint8_t  s_dmac_form;
+
+static uint32_t s_copy_crc;
+static uint32_t s_copy_bytes;
+
+static inline uint32_t crc_hw_conv(uint32_t v, uint8_t form)
+{
+    if ((form & CRC_HW_FORM_REV) != 0U)
+        v = __RBIT(v);
+    if ((form & CRC_HW_FORM_INV) != 0U)
+        v = ~v;
+    return v;
+}
+
+static inline bool crc_hw_expired(uint32_t t0)
+{
+    return (DWT->CYCCNT - t0) > CRC_HW_TIMEOUT_CYC;
+}
+
+/* ---------------- DSU ---------------- */
+
+static bool crc_dsu_run(uint32_t *reg, void *dst, const volatile void *src, uint32_t words)
+{
+    (void)dst;
+
+    DSU_REGS->DSU_STATUSA = (uint8_t)(DSU_STATUSA_DONE_Msk | DSU_STATUSA_BERR_Msk);
+    DSU_REGS->DSU_ADDR    = (uint32_t)(uintptr_t)src & DSU_ADDR_ADDR_Msk;
+    DSU_REGS->DSU_LENGTH  = (words * 4U) & DSU_LENGTH_LENGTH_Msk;
+    DSU_REGS->DSU_DATA    = *reg;
+    DSU_REGS->DSU_CTRL    = DSU_CTRL_CRC_Msk;
+
+    uint32_t t0 = DWT->CYCCNT;
+    while ((DSU_REGS->DSU_STATUSA & DSU_STATUSA_DONE_Msk) == 0U)
+    {
+        if (crc_hw_expired(t0))
+            return false;
+    }
+
+    if ((DSU_REGS->DSU_STATUSA & DSU_STATUSA_BERR_Msk) != 0U)
+        return false;
+
+    *reg = DSU_REGS->DSU_DATA;
+    return true;
+}
+
+/* ---------------- DMAC ---------------- */
+
+static void crc_dmac_channel_init(void)
+{
+    const uint8_t ch = QSPI_CRC_HW_DMA_CHANNEL;
+
+    DMAC_REGS->CHANNEL[ch].DMAC_CHCTRLA &= ~DMAC_CHCTRLA_ENABLE_Msk;
+    while ((DMAC_REGS->CHANNEL[ch].DMAC_CHCTRLA & DMAC_CHCTRLA_ENABLE_Msk) != 0U) { }
+
+    /* Software trigger, whole block per trigger, 4-beat bursts */
+    DMAC_REGS->CHANNEL[ch].DMAC_CHCTRLA =
+        DMAC_CHCTRLA_TRIGACT_TRANSACTION |
+        DMAC_CHCTRLA_TRIGSRC(0U) |
+        DMAC_CHCTRLA_BURSTLEN_4BEAT;
+    DMAC_REGS->CHANNEL[ch].DMAC_CHINTENCLR =
+        (DMAC_CHINTENCLR_TCMPL_Msk | DMAC_CHINTENCLR_TERR_Msk | DMAC_CHINTENCLR_SUSP_Msk);
+}
+
+/* Word copy src -> dst on the CRC channel, polled */
+static bool crc_dmac_run(uint32_t *reg, void *dst, const volatile void *src, uint32_t words)
+{
+    const uint8_t ch = QSPI_CRC_HW_DMA_CHANNEL;
+    DmacDescriptor_t *d = DMA_GetDescriptor(ch);
+    bool ok = true;
+
+    if (d == NULL)
+        return false;
+
+    d->btctrl   = (uint16_t)(DMAC_BTCTRL_VALID_Msk |
+                             DMAC_BTCTRL_BEATSIZE_WORD |
+                             DMAC_BTCTRL_SRCINC_Msk |
+                             DMAC_BTCTRL_DSTINC_Msk |
+                             DMAC_BTCTRL_BLOCKACT_NOACT);
+    d->btcnt    = (uint16_t)words;
+    d->srcaddr  = (uint32_t)(uintptr_t)src + (words * 4U);
+    d->dstaddr  = (uint32_t)(uintptr_t)dst + (words * 4U);
+    d->descaddr = 0U;
+
+    /* CHKSUM is only writable with the CRC source disabled */
+    DMAC_REGS->DMAC_CRCCTRL   = DMAC_CRCCTRL_RESETVALUE;
+    DMAC_REGS->DMAC_CRCSTATUS = (uint8_t)(DMAC_CRCSTATUS_CRCBUSY_Msk | DMAC_CRCSTATUS_CRCZERO_Msk);
+    DMAC_REGS->DMAC_CRCCHKSUM = *reg;
+    DMAC_REGS->DMAC_CRCCTRL   = (uint16_t)(DMAC_CRCCTRL_CRCBEATSIZE_WORD |
+                                           DMAC_CRCCTRL_CRCPOLY_CRC32 |
+                                           DMAC_CRCCTRL_CRCSRC(DMAC_CRCCTRL_CRCSRC_CHN0_Val + ch));
+
+    __DSB();
+    DMAC_REGS->CHANNEL[ch].DMAC_CHINTFLAG = (DMAC_CHINTFLAG_TCMPL_Msk | DMAC_CHINTFLAG_TERR_Msk);
+    DMAC_REGS->CHANNEL[ch].DMAC_CHCTRLA |= DMAC_CHCTRLA_ENABLE_Msk;
+    DMAC_REGS->DMAC_SWTRIGCTRL |= (1UL << ch);
+
+    uint32_t t0 = DWT->CYCCNT;
+    while ((DMAC_REGS->CHANNEL[ch].DMAC_CHINTFLAG &
+            (DMAC_CHINTFLAG_TCMPL_Msk | DMAC_CHINTFLAG_TERR_Msk)) == 0U)
+    {
+        if (crc_hw_expired(t0))
+        {
+            DMAC_REGS->CHANNEL[ch].DMAC_CHCTRLA &= ~DMAC_CHCTRLA_ENABLE_Msk;
+            ok = false;
+            break;
+        }
+    }
+
+    if ((DMAC_REGS->CHANNEL[ch].DMAC_CHINTFLAG & DMAC_CHINTFLAG_TERR_Msk) != 0U)
+        ok = false;
+
+    *reg = DMAC_REGS->DMAC_CRCCHKSUM;
+    DMAC_REGS->DMAC_CRCCTRL   = DMAC_CRCCTRL_RESETVALUE;
+    DMAC_REGS->DMAC_CRCSTATUS = DMAC_CRCSTATUS_CRCBUSY_Msk;
+    return ok;
+}
+
+/* ---------------- common ---------------- */
+
+/*
+ * Continue crc over a word-aligned run on an engine. Returns false (crc
+ * untouched) on a bus error or timeout.
+ */
+static bool crc_hw_words(crc_hw_run_t run, uint8_t form, uint32_t *crc,
+                         void *dst, const volatile void *src, uint32_t words)
+{
+    const volatile uint8_t *s = (const volatile uint8_t *)src;
+    uint8_t *d = (uint8_t *)dst;
+    uint32_t reg = crc_hw_conv(*crc, form);
+
+    while (words != 0U)
+    {
+        uint32_t n = (words > CRC_HW_DMA_MAX_WORDS) ? CRC_HW_DMA_MAX_WORDS : words;
+        if (!run(&reg, d, s, n))
+        {
+            s_stats.errors++;
+            return false;
+        }
+        s += n * 4U;
+        if (d != NULL)
+            d += n * 4U;
+        words -= n;
+    }
+
+    *crc = crc_hw_conv(reg, form);
+    return true;
+}
+
+/* The check string at a word boundary */
+static const char s_check_vec[12] __attribute__((aligned(4))) = "123456789";
+
+/*
+ * Find the register form under which the engine reproduces the software CRC:
+ * a hardware run on "12345678" continued in software with "9", and a software
+ * head "1234" continued on the engine with "5678" and in software with "9".
+ */
+static bool crc_hw_calibrate(crc_hw_run_t run, uint8_t *form_out)
+{
+    uint32_t scratch[2];
+
+    for (uint8_t form = 0U; form < CRC_HW_FORMS; form++)
+    {
+        uint32_t a = 0U;
+        if (!crc_hw_words(run, form, &a, scratch, s_check_vec, 2U))
+            return false;
+        a = QSPI_CRC32_Update(a, &s_check_vec[8], 1U);
+
+        uint32_t b = QSPI_CRC32(s_check_vec, 4U);
+        if (!crc_hw_words(run, form, &b, scratch, &s_check_vec[4], 1U))
+            return false;
+        b = QSPI_CRC32_Update(b, &s_check_vec[8], 1U);
+
+        if ((a == QSPI_CRC32_CHECK) && (b == QSPI_CRC32_CHECK))
+        {
+            *form_out = form;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool QSPI_CRC_HW_Init(void)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+
+    /* DSU sits behind PAC write protection after reset on some parts */
+    MCLK_REGS->MCLK_APBBMASK |= MCLK_APBBMASK_DSU_Msk;
+    if ((PAC_REGS->PAC_STATUSB & PAC_STATUSB_DSU_Msk) != 0U)
+        PAC_REGS->PAC_WRCTRL = PAC_WRCTRL_PERID(ID_DSU) | PAC_WRCTRL_KEY_CLR;
+
+    crc_dmac_channel_init();
+
+    s_stats.dsu  = crc_hw_calibrate(crc_dsu_run, &s_dsu_form);
+    s_stats.dmac = crc_hw_calibrate(crc_dmac_run, &s_dmac_form);
+
+    printf("[CRC] DSU %s, DMAC %s\r\n",
+           s_stats.dsu ? "OK" : "not used", s_stats.dmac ? "OK" : "not used");
+
+    if ((s_stats.dsu || s_stats.dmac) && !QSPI_CRC_HW_SelfTest())
+    {
+        printf("[CRC] hardware cross-check failed, software CRC only\r\n");
+        s_stats.dsu  = false;
+        s_stats.dmac = false;
+    }
+    return s_stats.dsu || s_stats.dmac;
+}
+
+uint32_t QSPI_CRC_HW_Buffer(const void *data, size_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    uint32_t crc = 0U;
+
+    if (!s_stats.dsu || (len < QSPI_CRC_HW_MIN_LEN))
+    {
+        s_stats.sw_bytes += (uint32_t)len;
+        return QSPI_CRC32(p, len);
+    }
+
+    uint32_t head = (uint32_t)((4U - ((uintptr_t)p & 3U)) & 3U);
+    uint32_t words = (uint32_t)((len - head) / 4U);
+    uint32_t tail = (uint32_t)(len - head - (words * 4U));
+
+    crc = QSPI_CRC32_Update(crc, p, head);
+    if (crc_hw_words(crc_dsu_run, s_dsu_form, &crc, NULL, p + head, words))
+    {
+        s_stats.dsu_bytes += words * 4U;
+    }
+    else
+    {
+        crc = QSPI_CRC32_Update(crc, p + head, words * 4U);
+        s_stats.sw_bytes += words * 4U;
+    }
+    crc = QSPI_CRC32_Update(crc, p + head + (words * 4U), tail);
+    s_stats.sw_bytes += head + tail;
+    return crc;
+}
+
+void QSPI_CRC_HW_CopyBegin(void)
+{
+    QSPI_CRC_HW_CopyContinue(0U);
+}
+
+void QSPI_CRC_HW_CopyContinue(uint32_t crc)
+{
+    s_copy_crc   = crc;
+    s_copy_bytes = 0U;
+    QSPI_HW_SetReadCopy(QSPI_CRC_HW_Copy);
+}
+
+void QSPI_CRC_HW_Copy(void *dst, const volatile void *src, size_t len)
+{
+    uint8_t *d = (uint8_t *)dst;
+    const volatile uint8_t *s = (const volatile uint8_t *)src;
+    uint32_t done = 0U;
+
+    if (s_stats.dmac && (len >= 4U) && ((((uintptr_t)d | (uintptr_t)s) & 3U) == 0U))
+    {
+        uint32_t words = (uint32_t)(len / 4U);
+        if (crc_hw_words(crc_dmac_run, s_dmac_form, &s_copy_crc, d, s, words))
+        {
+            done = words * 4U;
+            s_stats.dmac_bytes += done;
+        }
+    }
+
+    for (size_t i = done; i < len; i++)
+        d[i] = s[i];
+
+    s_copy_crc = QSPI_CRC32_Update(s_copy_crc, d + done, len - done);
+    s_stats.sw_bytes += (uint32_t)(len - done);
+    s_copy_bytes += (uint32_t)len;
+}
+
+uint32_t QSPI_CRC_HW_CopyEnd(uint32_t *bytes_out)
+{
+    QSPI_HW_SetReadCopy(NULL);
+    if (bytes_out != NULL)
+        *bytes_out = s_copy_bytes;
+    return s_copy_crc;
+}
+
+bool QSPI_CRC_HW_SelfTest(void)
+{
+    static const uint16_t lens[] = { 4U, 64U, 100U, 1021U, 4096U };
+    static uint8_t buf[4096U + 4U] __attribute__((aligned(4)));
+    static uint8_t out[4096U + 4U] __attribute__((aligned(4)));
+    bool ok = true;
+
+    for (uint32_t i = 0; i < sizeof(buf); i++)
+        buf[i] = (uint8_t)((i * 0x9E3779B1UL) >> 24);
+
+    for (uint32_t l = 0; l < (sizeof(lens) / sizeof(lens[0])); l++)
+    {
+        for (uint32_t off = 0; off < 4U; off++)
+        {
+            uint32_t ref = QSPI_CRC32(&buf[off], lens[l]);
+
+            if (s_stats.dsu && (QSPI_CRC_HW_Buffer(&buf[off], lens[l]) != ref))
+            {
+                printf("[CRC] DSU mismatch len=%u off=%lu\r\n", (unsigned)lens[l], (unsigned long)off);
+                ok = false;
+            }
+
+            if (s_stats.dmac)
+            {
+                s_copy_crc = 0U;
+                s_copy_bytes = 0U;
+                QSPI_CRC_HW_Copy(&out[off], &buf[off], lens[l]);
+                if ((s_copy_crc != ref) || (memcmp(&out[off], &buf[off], lens[l]) != 0))
+                {
+                    printf("[CRC] DMAC mismatch len=%u off=%lu\r\n", (unsigned)lens[l], (unsigned long)off);
+                    ok = false;
+                }
+            }
+        }
+    }
+    return ok;
+}
+
+void QSPI_CRC_HW_GetStats(qspi_crc_hw_stats_t *out)
+{
+    if (out != NULL)
+        *out = s_stats;
+}
+
+#else /* !QSPI_CRC_HW */
+
+bool QSPI_CRC_HW_Init(void)
+{
+    return false;
+}
+
+uint32_t QSPI_CRC_HW_Buffer(const void *data, size_t len)
+{
+    return QSPI_CRC32(data, len);
+}
+
+#endif /* QSPI_CRC_HW */
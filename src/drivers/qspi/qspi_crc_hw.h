@@ -0,0 +1,71 @@
+/* qspi_crc_hw.h: CRC-32 offload to the DMAC CRC unit and the DSU
+ *
+ * Both engines implement the IEEE 802.3 polynomial of qspi_crc32.c:
+ *
+ *  - DMAC (CRCCTRL/CRCCHKSUM): checksums the beats of one DMA channel as they
+ *    move. QSPI_CRC_HW_Copy() drains the QSPI AHB window with that channel, so
+ *    a payload read through it has its CRC when the copy ends
+ *    (QSPI_Flash_ReadAddr verify_crc).
+ *  - DSU (CTRL.CRC, ADDR/LENGTH/DATA): checksums a memory range over the bus
+ *    without the CPU. QSPI_CRC_HW_Buffer() uses it for buffers in RAM/flash.
+ *
+ * Both take word-aligned data, so unaligned heads and tails go through the
+ * software CRC. The register form of the checksum (bit order, complement) is
+ * worked out at init by comparing each engine with the software CRC on a
+ * known vector and on split runs; an engine that does not match is not used
+ * and everything falls back to QSPI_CRC32().
+ */
+
+#ifndef QSPI_CRC_HW_H
+#define QSPI_CRC_HW_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifndef QSPI_CRC_HW
+#define QSPI_CRC_HW                 1
+#endif
+
+/* DMAC channel for copy + CRC (0 = UART2 TX, 1/2 = QSPI SPI DMA, 3 = bench) */
+#define QSPI_CRC_HW_DMA_CHANNEL     4
+
+/* Below this many bytes the table CRC beats the engine setup */
+#define QSPI_CRC_HW_MIN_LEN         (64U)
+
+typedef struct
+{
+    bool     dsu;                   /* engine passed the init cross-check */
+    bool     dmac;
+    uint32_t dsu_bytes;
+    uint32_t dmac_bytes;
+    uint32_t sw_bytes;              /* heads/tails and fallbacks */
+    uint32_t errors;                /* bus errors / timeouts (fell back) */
+} qspi_crc_hw_stats_t;
+
+/* Calibrate and cross-check both engines. After UART2_DMA_Init() (DMAC on). */
+bool QSPI_CRC_HW_Init(void);
+
+/* CRC of a buffer in memory: DSU for the aligned middle, else software */
+uint32_t QSPI_CRC_HW_Buffer(const void *data, size_t len);
+
+/*
+ * Copy-with-CRC session for QSPI memory reads: Begin installs
+ * QSPI_CRC_HW_Copy() as the AHB copy routine, every read until End is copied
+ * by the DMAC and checksummed on the way. End restores the default copy and
+ * returns the CRC; *bytes_out lets the caller check that all the data it
+ * expects went through the session (register-frame reads bypass it).
+ */
+void QSPI_CRC_HW_CopyBegin(void);
+void QSPI_CRC_HW_Copy(void *dst, const volatile void *src, size_t len);
+uint32_t QSPI_CRC_HW_CopyEnd(uint32_t *bytes_out);
+/* Begin a session that continues crc (a previous CopyEnd result), so a
+ * stream read in several sessions yields one CRC */
+void QSPI_CRC_HW_CopyContinue(uint32_t crc);
+
+/* Cross-check both engines against QSPI_CRC32() over lengths/offsets */
+bool QSPI_CRC_HW_SelfTest(void);
+
+void QSPI_CRC_HW_GetStats(qspi_crc_hw_stats_t *out);
+
+#endif /* QSPI_CRC_HW_H */
@@ -3,35 +3,52 @@
 #include <string.h>
 #include "../../common/board.h"
 #include "../../common/systick.h"
+#include "../../common/delay.h"
+#include "../../common/cpu.h"
 #include "qspi_flash.h"
 #include "qspi_hw.h"
+#include "qspi_sfdp.h"
+#include "qspi_job.h"
+#include "qspi_wear.h"
+#include "qspi_log.h"
+#include "qspi_index.h"
+#include "qspi_cache.h"
+#include "qspi_crc32.h"
+#include "qspi_crc_hw.h"
 
 #if APP_USE_SST26_FLASH
 #include "sst26/sst26.h"
-#elif APP_USE_N25Q_FLASH
+#endif
+#if APP_USE_N25Q_FLASH
 #include "n25q/n25q256a.h"
 #endif
 
 uint8_t g_qspi_jedec_id[3];
 bool    g_qspi_jedec_valid;
 
-// --------- CRC32 (simple, tableless) ----------
-static uint32_t crc32_ieee(const void *data, size_t len)
+/* Devices this image can drive (JEDEC ID picks one at init) */
+static const qspi_flash_ops_t * const s_flash_devices[] =
 {
-    const uint8_t *p = (const uint8_t *)data;
-    uint32_t crc = 0xFFFFFFFFUL;
+#if APP_USE_SST26_FLASH
+    &g_sst26_flash_ops,
+#endif
+#if APP_USE_N25Q_FLASH
+    &g_n25q_flash_ops,
+#endif
+};
+
+static const qspi_flash_ops_t *s_ops = NULL;
+
+/* Selected driver table with the geometry fields overridden from SFDP */
+static qspi_flash_ops_t s_ops_rt;
+static qspi_sfdp_info_t s_sfdp;
+
+/* Generic SPI-protocol opcodes used for the probe (before a driver is chosen) */
+#define QSPI_PROBE_CMD_RESET_QIO        (0xFFU)   /* SST26 RSTQIO (in SQI)   */
+#define QSPI_PROBE_CMD_RESET_ENABLE     (0x66U)
+#define QSPI_PROBE_CMD_RESET            (0x99U)
+#define QSPI_PROBE_CMD_JEDEC_ID         (0x9FU)
 
-    for (size_t i = 0; i < len; i++)
-    {
-        crc ^= p[i];
-        for (int b = 0; b < 8; b++)
-        {
-            uint32_t mask = (uint32_t)-(int32_t)(crc & 1U);
-            crc = (crc >> 1) ^ (0xEDB88320UL & mask);
-        }
-    }
-    return ~crc;
-}
 #if QSPI_FLASH_TIMELOG
 static inline void qspi_timelog_print(const char *op, bool ok, uint32_t t_start_ms,
                                       uint32_t addr, uint32_t len_hint)
@@ -58,17 +75,26 @@ static inline void qspi_timelog_print(const char *op, bool ok, uint32_t t_start_
 #endif
 }
 #endif
+static inline bool flash_read_raw(void *rx, uint32_t len, uint32_t addr)
+{
+#if QSPI_FLASH_CONT_READ
+    if (s_ops->read_cont != NULL)
+        return s_ops->read_cont(rx, len, addr);
+#endif
+    return s_ops->read(rx, len, addr);
+}
+
 /* Read flash in small chunks to avoid big stack/heap */
 static bool flash_read_chunked(uint32_t addr, void *dst, uint32_t len)
 {
     uint8_t *out = (uint8_t *)dst;
-    uint8_t rb[64];
+    uint8_t rb[64] __attribute__((aligned(4)));     /* word DMA for the CRC copy */
 
     while (len)
     {
         uint32_t n = (len > sizeof(rb)) ? (uint32_t)sizeof(rb) : len;
 
-        if (!SST26_HighSpeedRead(rb, n, addr))
+        if (!flash_read_raw(rb, n, addr))
             return false;
 
         memcpy(out, rb, n);
@@ -81,18 +107,149 @@ static bool flash_read_chunked(uint32_t addr, void *dst, uint32_t len)
 }
 
 /*
- * QSPI flash init sequence (SAME54 Xplained Pro + N25Q256A):
+ * Bring every supported part back to 1-1-1 and read the JEDEC ID with 9Fh.
+ * A previous run (MCU reset without power cycle) may have left the flash in
+ * SQI/quad protocol, so the quad forms of RSTQIO and reset go out first;
+ * a part already in SPI protocol ignores them (only 2 clocks with CS low).
+ */
+static bool flash_probe_jedec(uint32_t *jedec_out)
+{
+    uint8_t id[3] = { 0U, 0U, 0U };
+
+    (void)QSPI_HW_Command(QSPI_PROBE_CMD_RESET_QIO,     QSPI_WIDTH_QUAD_CMD);
+    (void)QSPI_HW_Command(QSPI_PROBE_CMD_RESET_ENABLE, QSPI_WIDTH_QUAD_CMD);
+    (void)QSPI_HW_Command(QSPI_PROBE_CMD_RESET,        QSPI_WIDTH_QUAD_CMD);
+
+    if (!QSPI_HW_Command(QSPI_PROBE_CMD_RESET_ENABLE, QSPI_WIDTH_SINGLE_BIT_SPI) ||
+        !QSPI_HW_Command(QSPI_PROBE_CMD_RESET, QSPI_WIDTH_SINGLE_BIT_SPI))
+    {
+        return false;
+    }
+    DelayUs(100U);  /* tRST/tSHSL2 */
+
+    if (!QSPI_HW_Read(QSPI_PROBE_CMD_JEDEC_ID, QSPI_WIDTH_SINGLE_BIT_SPI, id, sizeof(id)))
+    {
+        return false;
+    }
+
+    *jedec_out = ((uint32_t)id[0]) | ((uint32_t)id[1] << 8) | ((uint32_t)id[2] << 16);
+    return true;
+}
+
+#if QSPI_FLASH_SFDP
+/*
+ * Take the geometry the part reports over the driver defaults.
+ * A larger SFDP density is not taken: the driver capacity is also its
+ * addressing limit (e.g. a 3-byte-address driver on a bigger part). The driver's sector erase
+ * is the 4K erase (20h) on every supported part, so sector_size follows the
+ * SFDP 4K erase bit; the generic driver already uses the SFDP values.
+ */
+static void flash_apply_sfdp(qspi_flash_ops_t *ops, const qspi_sfdp_info_t *sfdp)
+{
+    if (!sfdp->valid)
+        return;
+
+    if (sfdp->capacity < ops->capacity)
+    {
+        printf("[QSPI] SFDP: capacity %lu KB (driver %lu KB)\r\n",
+               (unsigned long)(sfdp->capacity / 1024UL),
+               (unsigned long)(ops->capacity / 1024UL));
+        ops->capacity = sfdp->capacity;
+    }
+
+    if ((sfdp->bfpt_dwords >= 11U) && (sfdp->page_size != ops->page_size))
+    {
+        printf("[QSPI] SFDP: page %lu (driver %lu)\r\n",
+               (unsigned long)sfdp->page_size, (unsigned long)ops->page_size);
+        ops->page_size = sfdp->page_size;
+    }
+
+    if (!sfdp->erase_4k && (ops->sector_size == 4096U))
+    {
+        uint32_t min_erase = QSPI_SFDP_MinErase(sfdp, NULL);
+        printf("[QSPI] SFDP: no 4K erase, sector %lu\r\n", (unsigned long)min_erase);
+        if (min_erase != 0U)
+            ops->sector_size = min_erase;
+    }
+}
+#endif
+
+/* Object header of the sector store: magic, length, non-empty payload, CRC */
+static bool flash_hdr_valid(qspi_obj_hdr_t hdr)
+{
+    uint32_t saved_hcrc = hdr.header_crc;
+
+    if ((hdr.magic != QSPI_OBJ_MAGIC) || (hdr.header_len != (uint16_t)sizeof(qspi_obj_hdr_t)) ||
+        (hdr.payload_len == 0U))
+        return false;
+    hdr.header_crc = 0U;
+    return QSPI_CRC32(&hdr, sizeof(hdr)) == saved_hcrc;
+}
+
+#if QSPI_FLASH_INDEX
+static qspi_index_entry_t s_index_slots[QSPI_FLASH_INDEX_SLOTS];
+static qspi_index_t       s_index;
+static uint32_t           s_index_dups;     /* same type_id in two places */
+static bool               s_view_stale;     /* objects rewritten since the last view */
+static uint32_t           s_view_count;
+static uint32_t           s_view_verifies;
+
+_Static_assert((QSPI_FLASH_INDEX_SLOTS & (QSPI_FLASH_INDEX_SLOTS - 1U)) == 0U,
+               "QSPI_FLASH_INDEX_SLOTS must be a power of two");
+
+/*
+ * Build the type_id index from the object store headers: one header read
+ * per slot, skipping the sectors a multi-sector payload covers. If a type
+ * shows up twice (interrupted rewrite at another address), the higher
+ * version wins, else the first one found.
+ */
+static void flash_index_scan(void)
+{
+    uint32_t t0 = DWT->CYCCNT;
+    const uint32_t end = QSPI_OBJ_STORE_BASE + (QSPI_OBJ_MAX_SECTORS * QSPI_OBJ_SECTOR_SIZE);
+
+    QSPI_Index_Init(&s_index, s_index_slots, QSPI_FLASH_INDEX_SLOTS);
+    s_index_dups = 0U;
+
+    for (uint32_t addr = QSPI_OBJ_STORE_BASE; addr < end; )
+    {
+        qspi_obj_hdr_t hdr;
+        uint32_t step = QSPI_OBJ_SECTOR_SIZE;
+
+        if (flash_read_chunked(addr, &hdr, (uint32_t)sizeof(hdr)) && flash_hdr_valid(hdr))
+        {
+            const qspi_index_entry_t *old = QSPI_Index_Get(&s_index, hdr.type_id);
+            const qspi_index_entry_t e = { hdr.type_id, addr, hdr.payload_len, hdr.version, 0U, 0U };
+
+            if (old != NULL)
+                s_index_dups++;
+            if ((old == NULL) || (hdr.version > old->version))
+                (void)QSPI_Index_Put(&s_index, &e);
+
+            uint32_t total = (uint32_t)sizeof(hdr) + hdr.payload_len;
+            step = ((total + QSPI_OBJ_SECTOR_SIZE - 1U) / QSPI_OBJ_SECTOR_SIZE) * QSPI_OBJ_SECTOR_SIZE;
+        }
+        addr += step;
+    }
+
+    printf("[QSPI] index: %lu objects in %lu us%s\r\n",
+           (unsigned long)s_index.count,
+           (unsigned long)((DWT->CYCCNT - t0) / (uint32_t)(CPU_CLOCK_HZ / 1000000UL)),
+           (s_index.dropped != 0U) ? " (FULL: raise QSPI_FLASH_INDEX_SLOTS)" : "");
+}
+#endif
+
+/*
+ * QSPI flash init sequence (SST26VF064B or N25Q256A, chosen at runtime):
  *  1) Init QSPI peripheral (AHB clocks + reset + basic CTRLB/BAUD)
- *  2) Reset flash (66h/99h)
- *  3) Read JEDEC ID (9Fh)
- *  4) Enable Quad I/O via Enhanced Volatile Config Register (61h)
- *  5) Program Volatile Config Register dummy cycles (81h)
- *  6) Enter 4-byte addressing (B7h)
- *  7) Configure SAME54 QSPI memory-read instruction frame for XIP-style reads
+ *  2) Probe: reset to 1-1-1, read JEDEC ID (9Fh) and SFDP (5Ah)
+ *  3) Select the matching qspi_flash_ops_t (or the generic SFDP driver)
+ *     and apply the SFDP geometry to a RAM copy of it
+ *  4) ops->init(): driver reset + quad/SQI enable + unprotect
+ *  5) Re-read the JEDEC ID in the new protocol as a bus check
  */
 bool QSPI_Flash_Init(void)
 {
-#if APP_USE_SST26_FLASH
     uint32_t jedec = 0;
 
     /* Harmony: QSPI_Initialize() */
@@ -100,103 +257,119 @@ bool QSPI_Flash_Init(void)
     QSPI_HW_Enable();
 //    QSPI_HW_Initialize();
 
-    /* Harmony APP_STATE_RESET_FLASH */
-    if (!SST26_Reset())
+    g_qspi_jedec_valid = false;
+    s_ops = NULL;
+
+    if (!QSPI_CRC32_Init())
     {
-        printf("[QSPI] SST26_Reset failed\r\n");
+        printf("[QSPI] CRC32 self-test failed\r\n");
         return false;
     }
+#if QSPI_CRC_HW
+    (void)QSPI_CRC_HW_Init();
+#endif
 
-    /* Harmony APP_STATE_ENABLE_QUAD_IO */
-    if (!SST26_EnableQuadIO())
+    if (!flash_probe_jedec(&jedec))
     {
-        printf("[QSPI] SST26_EnableQuadIO failed\r\n");
+        printf("[QSPI] JEDEC probe failed\r\n");
         return false;
     }
 
-    /* Harmony APP_STATE_UNLOCK_FLASH (WREN + Global Unprotect) */
-    if (!SST26_UnlockGlobal())
+    const qspi_flash_ops_t *base = NULL;
+    for (uint32_t i = 0; i < (sizeof(s_flash_devices) / sizeof(s_flash_devices[0])); i++)
+    {
+        if (s_flash_devices[i]->jedec_id == jedec)
+        {
+            base = s_flash_devices[i];
+            break;
+        }
+    }
+
+#if QSPI_FLASH_SFDP
+    /* Still in 1-1-1 after the probe: the only protocol 5Ah is defined in */
+    if (!QSPI_SFDP_Read(&s_sfdp))
     {
-        printf("[QSPI] SST26_UnlockGlobal failed\r\n");
+        printf("[QSPI] SFDP not available, using driver geometry\r\n");
+    }
+
+    if (base == NULL)
+    {
+        base = QSPI_SFDP_GenericOps(&s_sfdp, jedec);
+    }
+#else
+    s_sfdp.valid = false;
+#endif
+
+    if (base == NULL)
+    {
+        printf("QSPI: JEDEC ID = 0x%06lX not supported\r\n",
+               (unsigned long)(jedec & 0x00FFFFFFUL));
         return false;
     }
 
-    /* Harmony APP_STATE_READ_JEDEC_ID uses 0xAF (QUAD), dummy=2, len=3 */
-    if (!SST26_ReadJEDEC(&jedec))
+    s_ops_rt = *base;
+#if QSPI_FLASH_SFDP
+    flash_apply_sfdp(&s_ops_rt, &s_sfdp);
+#endif
+#if QSPI_CACHE_ENABLE
+    QSPI_Cache_Attach(&s_ops_rt);
+#endif
+    s_ops = &s_ops_rt;
+
+    if (!s_ops->init())
     {
-        printf("[QSPI] SST26_ReadJEDEC failed\r\n");
         return false;
     }
-    g_qspi_jedec_id[0] = (uint8_t)((jedec >> 0)  & 0xFF);   // 0xBF
-    g_qspi_jedec_id[1] = (uint8_t)((jedec >> 8)  & 0xFF);   // 0x26
-    g_qspi_jedec_id[2] = (uint8_t)((jedec >> 16) & 0xFF);   // 0x43
 
-    printf("QSPI: JEDEC ID = 0x%06lX\r\n", (unsigned long)(jedec & 0x00FFFFFFUL));
+    if (!s_ops->read_jedec(&jedec))
+    {
+        printf("[QSPI] %s read JEDEC failed\r\n", s_ops->name);
+        return false;
+    }
+    g_qspi_jedec_id[0] = (uint8_t)((jedec >> 0)  & 0xFF);   // 0xBF / 0x20
+    g_qspi_jedec_id[1] = (uint8_t)((jedec >> 8)  & 0xFF);   // 0x26 / 0xBA
+    g_qspi_jedec_id[2] = (uint8_t)((jedec >> 16) & 0xFF);   // 0x43 / 0x19
+    printf("QSPI: JEDEC ID = 0x%06lX (%s)\r\n",
+           (unsigned long)(jedec & 0x00FFFFFFUL), s_ops->name);
 
-    if (jedec != SST26VF064B_JEDEC_ID)
+    if (jedec != s_ops->jedec_id)
     {
-		g_qspi_jedec_valid = false;
         printf("QSPI: JEDEC mismatch. expected=0x%06lX\r\n",
-               (unsigned long)(SST26VF064B_JEDEC_ID & 0x00FFFFFFUL));
+               (unsigned long)(s_ops->jedec_id & 0x00FFFFFFUL));
         return false;
     }
 	g_qspi_jedec_valid = true;
-  
-
-    return true;
 
-#elif APP_USE_N25Q_FLASH
-    /* (keep your old N25Q flow here if you want) */
-    return false;
+#if QSPI_FLASH_SCRAMBLE
+    if (!QSPI_HW_Scramble_Config(QSPI_FLASH_SCRAMBLE_KEY,
+                                 QSPI_FLASH_SCRAMBLE_BASE,
+                                 QSPI_FLASH_SCRAMBLE_SIZE,
+                                 (QSPI_FLASH_SCRAMBLE_CHIP_UNIQUE != 0)))
+    {
+        printf("[QSPI] Scramble config failed (base/size not 4K aligned or above 16 MB)\r\n");
+        return false;
+    }
 #endif
-}
 
-static bool flash_write_pages(uint32_t addr, const uint8_t *src, uint32_t len)
-{
-    // Programs must not cross SST26_PAGE_SIZE boundaries.
-    while (len)
-    {
-        uint32_t page_off = addr % SST26_PAGE_SIZE;
-        uint32_t chunk = SST26_PAGE_SIZE - page_off;
-        if (chunk > len) chunk = len;
+#if QSPI_FLASH_INDEX
+    flash_index_scan();
+#endif
 
-        // IMPORTANT: SST26_PageProgram() will happily accept any len,
-        // but the FLASH itself will wrap if we cross page boundary.
-        if (!SST26_PageProgram(src, chunk, addr))
-            return false;
+#if QSPI_WEAR_ENABLE
+    /* counters are bookkeeping only: the flash stays usable without them */
+    (void)QSPI_Wear_Init();
+#endif
 
-        // Wait for WIP to clear after each program
-        if (!SST26_WaitWhileBusy(SST26_FT_PAGE_PROG_LOOPS))
-            return false;
+#if QSPI_LOG_ENABLE
+    (void)QSPI_Log_Mount();
+#endif
 
-        addr += chunk;
-        src  += chunk;
-        len  -= chunk;
-    }
     return true;
 }
 
-static bool flash_verify(uint32_t addr, const void *ref, uint32_t len)
+const qspi_flash_ops_t *QSPI_Flash_Ops(void)
 {
-    // Small-buffer verify to avoid big stack usage
-    uint8_t rb[64];
-    const uint8_t *exp = (const uint8_t *)ref;
-
-    while (len)
-    {
-        uint32_t n = (len > sizeof(rb)) ? sizeof(rb) : len;
-
-        if (!SST26_HighSpeedRead(rb, n, addr))
-            return false;
-
-        if (memcmp(rb, exp, n) != 0)
-            return false;
-
-        addr += n;
-        exp  += n;
-        len  -= n;
-    }
-    return true;
+    return g_qspi_jedec_valid ? s_ops : NULL;
 }
 
 /*
@@ -221,53 +394,64 @@ bool QSPI_Flash_ReadAddr(uint32_t address,
     uint32_t t_start_ms = millis();
 #endif
     bool ok = false;
+    bool suspended = false;
     uint32_t len_hint = obj_max_len;   // will update to payload_len if header validated
 
-    if ((obj_out == NULL) || (obj_max_len == 0U))
+    if ((obj_out == NULL) || (obj_max_len == 0U) || !g_qspi_jedec_valid)
         goto out;
 
-    // 1) Read header
-    qspi_obj_hdr_t hdr;
-    if (!flash_read_chunked(address, &hdr, (uint32_t)sizeof(hdr)))
+    // 0) A background write may be erasing/programming: suspend it, over
+    //    the header only until the real payload length is known
+    if (!QSPI_Job_Suspend(address, (uint32_t)sizeof(qspi_obj_hdr_t)))
         goto out;
 
-    // 2) Empty / erased region
-    if (hdr.magic == 0xFFFFFFFFUL)
-        goto out;
-
-    // 3) Header basics
-    if (hdr.magic != QSPI_OBJ_MAGIC)
-        goto out;
-
-    if (hdr.header_len != (uint16_t)sizeof(qspi_obj_hdr_t))
+    // 1) Read header
+    qspi_obj_hdr_t hdr;
+    bool hdr_ok = flash_read_chunked(address, &hdr, (uint32_t)sizeof(hdr));
+    QSPI_Job_Resume();
+    if (!hdr_ok)
         goto out;
 
-    if (hdr.payload_len == 0U)
+    // 2) Empty / erased region, header basics, header CRC
+    if (!flash_hdr_valid(hdr))
         goto out;
 
+    // 3) Fits the caller's buffer
     if (hdr.payload_len > obj_max_len)
         goto out;
 
     len_hint = hdr.payload_len; // now we know the real payload size
 
-    // 4) Header CRC verify
-    uint32_t saved_hcrc = hdr.header_crc;
-    hdr.header_crc = 0U;
-    uint32_t calc_hcrc = crc32_ieee(&hdr, sizeof(hdr));
-    hdr.header_crc = saved_hcrc;
-
-    if (calc_hcrc != saved_hcrc)
+    // 4) Suspend over the payload itself, not the caller's buffer size
+    uint32_t payload_addr = address + (uint32_t)sizeof(qspi_obj_hdr_t);
+    if (!QSPI_Job_Suspend(payload_addr, hdr.payload_len))
         goto out;
+    suspended = true;
 
-    // 5) Read payload
-    uint32_t payload_addr = address + (uint32_t)sizeof(qspi_obj_hdr_t);
-    if (!flash_read_chunked(payload_addr, obj_out, hdr.payload_len))
+    // 5) Read payload; with verify_crc the DMAC checksums it on the way
+    uint32_t calc_pcrc = 0U;
+    bool pcrc_done = false;
+#if QSPI_CRC_HW
+    if (verify_crc)
+        QSPI_CRC_HW_CopyBegin();
+#endif
+    bool rd_ok = flash_read_chunked(payload_addr, obj_out, hdr.payload_len);
+#if QSPI_CRC_HW
+    if (verify_crc)
+    {
+        uint32_t crc_bytes;
+        calc_pcrc = QSPI_CRC_HW_CopyEnd(&crc_bytes);
+        pcrc_done = (crc_bytes == hdr.payload_len);    /* register-frame reads bypass it */
+    }
+#endif
+    if (!rd_ok)
         goto out;
 
     // 6) Optional payload CRC
     if (verify_crc)
     {
-        uint32_t calc_pcrc = crc32_ieee(obj_out, hdr.payload_len);
+        if (!pcrc_done)
+            calc_pcrc = QSPI_CRC_HW_Buffer(obj_out, hdr.payload_len);
         if (calc_pcrc != hdr.payload_crc)
             goto out;
     }
@@ -278,12 +462,152 @@ bool QSPI_Flash_ReadAddr(uint32_t address,
     ok = true;
 
 out:
+    if (suspended)
+        QSPI_Job_Resume();
 #if QSPI_FLASH_TIMELOG
     qspi_timelog_print("Read", ok, t_start_ms, address, len_hint);
 #endif
     return ok;
 }
 
+/*
+ * QSPI_Flash_ReadData()
+ * --------------------
+ * Raw read of [address, address + len), no header. A background job is
+ * suspended around it like in QSPI_Flash_ReadAddr(). crc_out (optional)
+ * receives the CRC32 of the data, taken by the DMAC during the copy when
+ * the hardware CRC is available.
+ */
+bool QSPI_Flash_ReadData(uint32_t address, void *dst, uint32_t len, uint32_t *crc_out)
+{
+    if ((dst == NULL) || (len == 0U) || !g_qspi_jedec_valid)
+        return false;
+    if (!QSPI_Job_Suspend(address, len))
+        return false;
+
+    uint32_t crc = 0U;
+    bool crc_done = false;
+#if QSPI_CRC_HW
+    if (crc_out != NULL)
+        QSPI_CRC_HW_CopyBegin();
+#endif
+    bool ok = flash_read_chunked(address, dst, len);
+#if QSPI_CRC_HW
+    if (crc_out != NULL)
+    {
+        uint32_t crc_bytes;
+        crc = QSPI_CRC_HW_CopyEnd(&crc_bytes);
+        crc_done = (crc_bytes == len);
+    }
+#endif
+    QSPI_Job_Resume();
+
+    if (ok && (crc_out != NULL))
+        *crc_out = crc_done ? crc : QSPI_CRC_HW_Buffer(dst, len);
+    return ok;
+}
+
+/*
+ * QSPI_Flash_ReadDataStream()
+ * ---------------------------
+ * [address, address + len) through buf, buf_len bytes at a time: each
+ * chunk is read (job suspended for that chunk only) and handed to cb before
+ * the next one. crc_inout (optional) is a running CRC32 (0 to start),
+ * continued across the chunks by the DMAC copy session, so the payload is
+ * never in RAM as a whole. cb returning false stops the stream.
+ */
+bool QSPI_Flash_ReadDataStream(uint32_t address, uint32_t len,
+                               void *buf, uint32_t buf_len,
+                               qspi_flash_chunk_cb_t cb, void *ctx,
+                               uint32_t *crc_inout)
+{
+    if ((buf == NULL) || (buf_len == 0U) || (cb == NULL) || !g_qspi_jedec_valid)
+        return false;
+
+    uint32_t crc = (crc_inout != NULL) ? *crc_inout : 0U;
+
+    for (uint32_t off = 0; off < len; )
+    {
+        uint32_t n = ((len - off) > buf_len) ? buf_len : (len - off);
+
+        if (!QSPI_Job_Suspend(address + off, n))
+            return false;
+
+        bool crc_done = false;
+#if QSPI_CRC_HW
+        if (crc_inout != NULL)
+            QSPI_CRC_HW_CopyContinue(crc);
+#endif
+        bool ok = flash_read_chunked(address + off, buf, n);
+#if QSPI_CRC_HW
+        if (crc_inout != NULL)
+        {
+            uint32_t crc_bytes;
+            uint32_t c = QSPI_CRC_HW_CopyEnd(&crc_bytes);
+            crc_done = (crc_bytes == n);
+            if (crc_done)
+                crc = c;
+        }
+#endif
+        QSPI_Job_Resume();
+        if (!ok)
+            return false;
+
+        if ((crc_inout != NULL) && !crc_done)
+            crc = QSPI_CRC32_Update(crc, buf, n);
+        if (!cb(buf, off, n, ctx))
+            return false;
+        off += n;
+    }
+
+    if (crc_inout != NULL)
+        *crc_inout = crc;
+    return true;
+}
+
+/*
+ * QSPI_Flash_ReadStream()
+ * -----------------------
+ * QSPI_Flash_ReadAddr() for payloads larger than RAM: the header is checked
+ * first, then the payload goes to cb in chunks of buf_len. With verify_crc
+ * the result says whether the chunks already delivered were intact, so cb
+ * should stage its output and only commit to it on success.
+ */
+bool QSPI_Flash_ReadStream(uint32_t address,
+                           void *buf, uint32_t buf_len,
+                           qspi_flash_chunk_cb_t cb, void *ctx,
+                           qspi_obj_hdr_t *hdr_out,
+                           bool verify_crc)
+{
+#if QSPI_FLASH_TIMELOG
+    uint32_t t_start_ms = millis();
+#endif
+    qspi_obj_hdr_t hdr;
+    uint32_t crc = 0U;
+    uint32_t len_hint = 0U;
+    bool ok = false;
+
+    if (!QSPI_Flash_ReadData(address, &hdr, (uint32_t)sizeof(hdr), NULL) ||
+        !flash_hdr_valid(hdr))
+        goto out;
+    len_hint = hdr.payload_len;
+
+    if (!QSPI_Flash_ReadDataStream(address + (uint32_t)sizeof(hdr), hdr.payload_len,
+                                   buf, buf_len, cb, ctx, verify_crc ? &crc : NULL))
+        goto out;
+    if (verify_crc && (crc != hdr.payload_crc))
+        goto out;
+
+    if (hdr_out != NULL)
+        *hdr_out = hdr;
+    ok = true;
+
+out:
+#if QSPI_FLASH_TIMELOG
+    qspi_timelog_print("ReadStream", ok, t_start_ms, address, len_hint);
+#endif
+    return ok;
+}
 
 bool QSPI_Flash_ReadSector(int sector,
                            void *obj_out, uint32_t obj_max_len,
@@ -296,10 +620,120 @@ bool QSPI_Flash_ReadSector(int sector,
     if ((uint32_t)sector >= QSPI_OBJ_MAX_SECTORS)
         return false;
 
-    uint32_t addr = QSPI_OBJ_STORE_BASE + ((uint32_t)sector * SST26_SECTOR_SIZE);
+    uint32_t addr = QSPI_OBJ_STORE_BASE + ((uint32_t)sector * QSPI_OBJ_SECTOR_SIZE);
     return QSPI_Flash_ReadAddr(addr, obj_out, obj_max_len, hdr_out, verify_crc);
 }
 
+/* Header of the object being written (the job engine programs from it) */
+static qspi_obj_hdr_t s_write_hdr;
+
+#if QSPI_FLASH_INDEX
+static uint32_t       s_write_addr;
+static qspi_job_cb_t  s_write_cb;
+static void          *s_write_ctx;
+
+static void flash_index_put(uint32_t address, const qspi_obj_hdr_t *hdr)
+{
+    s_view_stale = true;
+    const qspi_index_entry_t e = { hdr->type_id, address, hdr->payload_len, hdr->version, 0U, 0U };
+    if (!QSPI_Index_Put(&s_index, &e))
+        printf("[QSPI] index full, type %lu not indexed\r\n", (unsigned long)e.type_id);
+}
+
+/* Job completion: the object is on flash, point the index at it */
+static void flash_write_done(bool ok, void *ctx)
+{
+    (void)ctx;
+
+    if (ok)
+        flash_index_put(s_write_addr, &s_write_hdr);
+    if (s_write_cb != NULL)
+        s_write_cb(ok, s_write_ctx);
+}
+#endif
+
+static void flash_obj_hdr_build(qspi_obj_hdr_t *hdr, uint32_t type_id, uint32_t version,
+                                uint32_t payload_len, uint32_t payload_crc)
+{
+    hdr->magic       = QSPI_OBJ_MAGIC;
+    hdr->header_len  = (uint16_t)sizeof(*hdr);
+    hdr->flags       = 0U;
+    hdr->type_id     = type_id;
+    hdr->version     = version;
+    hdr->payload_len = payload_len;
+    hdr->payload_crc = payload_crc;
+
+    hdr->header_crc  = 0U;
+    hdr->header_crc  = QSPI_CRC32(hdr, sizeof(*hdr));
+}
+
+/* Metadata area of the erase counters; not writable through this API */
+static bool flash_reserved(uint32_t address, uint32_t len)
+{
+#if QSPI_WEAR_ENABLE
+    if (QSPI_Wear_Overlaps(address, len))
+    {
+        printf("[QSPI] 0x%06lX+%lu overlaps the wear counter area\r\n",
+               (unsigned long)address, (unsigned long)len);
+        return true;
+    }
+#endif
+#if QSPI_LOG_ENABLE
+    if (QSPI_Log_Overlaps(address, len))
+    {
+        printf("[QSPI] 0x%06lX+%lu overlaps the log store\r\n",
+               (unsigned long)address, (unsigned long)len);
+        return true;
+    }
+#endif
+    (void)address;
+    (void)len;
+    return false;
+}
+
+/*
+ * Build the header and queue erase -> program header -> program payload ->
+ * verify as one flash job. The erase covers every sector the object touches.
+ */
+static bool flash_write_obj_start(uint32_t address,
+                                  const void *obj, uint32_t obj_len,
+                                  uint32_t type_id, uint32_t version,
+                                  qspi_job_cb_t cb, void *ctx)
+{
+    if ((obj == NULL) || (obj_len == 0U) || !g_qspi_jedec_valid)
+        return false;
+    if (flash_reserved(address, (uint32_t)sizeof(qspi_obj_hdr_t) + obj_len))
+        return false;
+
+    /* wear flush / log GC queue jobs from the superloop: let theirs finish */
+    if (QSPI_Job_IsBusy())
+        (void)QSPI_Job_Wait();
+
+    // 1) Build header in RAM
+    qspi_obj_hdr_t *hdr = &s_write_hdr;
+    flash_obj_hdr_build(hdr, type_id, version, obj_len, QSPI_CRC_HW_Buffer(obj, obj_len));
+
+    // 2) Segments: header, then payload right behind it
+    const qspi_job_seg_t segs[2] =
+    {
+        { address,                            hdr, (uint32_t)sizeof(*hdr) },
+        { address + (uint32_t)sizeof(*hdr),   obj, obj_len },
+    };
+    uint32_t total_len = (uint32_t)sizeof(*hdr) + obj_len;
+
+    // 3) Erase touched sectors, program, verify
+#if QSPI_FLASH_INDEX
+    /* whatever the range held is gone, even if the blank check skips the erase */
+    QSPI_Index_RemoveRange(&s_index, address, total_len, (uint32_t)sizeof(*hdr));
+    s_write_addr = address;
+    s_write_cb   = cb;
+    s_write_ctx  = ctx;
+    return QSPI_Job_Write(address, total_len, segs, 2U, true, flash_write_done, NULL);
+#else
+    return QSPI_Job_Write(address, total_len, segs, 2U, true, cb, ctx);
+#endif
+}
+
 /*
  * QSPI_Flash_WriteAddr()
  * ---------------------
@@ -307,6 +741,8 @@ bool QSPI_Flash_ReadSector(int sector,
  *
  * This function is "destructive" to the sectors it touches:
  * it will ERASE required sectors first, then program.
+ * It runs the job engine to completion; the idle hook
+ * (QSPI_Job_SetIdleHook) keeps the application tasks running meanwhile.
  *
  * address: flash offset (0..flash_size-1)
  */
@@ -317,65 +753,184 @@ bool QSPI_Flash_WriteAddr(uint32_t address,
 #if QSPI_FLASH_TIMELOG
     uint32_t t_start_ms = millis();
 #endif
-    bool ok = false;
+    bool ok = flash_write_obj_start(address, obj, obj_len, type_id, version, NULL, NULL) &&
+              QSPI_Job_Wait();
 
-    if ((obj == NULL) || (obj_len == 0U))
-        goto out;
+#if QSPI_FLASH_TIMELOG
+    qspi_timelog_print("Write", ok, t_start_ms, address, obj_len);
+#endif
+    return ok;
+}
 
-    // 1) Build header in RAM
-    qspi_obj_hdr_t hdr;
-    hdr.magic       = QSPI_OBJ_MAGIC;
-    hdr.header_len  = (uint16_t)sizeof(hdr);
-    hdr.flags       = 0U;
-    hdr.type_id     = type_id;
-    hdr.version     = version;
-    hdr.payload_len = obj_len;
-    hdr.payload_crc = crc32_ieee(obj, obj_len);
+/*
+ * QSPI_Flash_WriteAddrAsync()
+ * --------------------------
+ * Same as QSPI_Flash_WriteAddr() but returns once the job is queued;
+ * QSPI_Job_Task() advances it and cb reports the result. A background
+ * job already running (wear flush, log GC) is waited for first.
+ * obj must stay valid until cb runs.
+ */
+bool QSPI_Flash_WriteAddrAsync(uint32_t address,
+                               const void *obj, uint32_t obj_len,
+                               uint32_t type_id, uint32_t version,
+                               qspi_job_cb_t cb, void *ctx)
+{
+    return flash_write_obj_start(address, obj, obj_len, type_id, version, cb, ctx);
+}
 
-    hdr.header_crc  = 0U;
-    hdr.header_crc  = crc32_ieee(&hdr, sizeof(hdr));
 
-    // 2) Compute total write size
-    uint32_t total_len = (uint32_t)sizeof(hdr) + obj_len;
+/*
+ * Write sessions
+ * --------------
+ * For payloads that arrive in pieces (UART RX, a decoder): Begin erases
+ * [address, address + header + max_len), Append programs the payload page
+ * by page as the session buffer fills and keeps a running CRC, Commit
+ * programs the rest and then the header. Until the header is on flash the
+ * range reads as empty (erased magic), so a reset or an abort leaves no
+ * object, and a reader never sees a partial one.
+ * Page programs are blocking through the job engine (idle hook runs).
+ */
+static bool flash_session_program(qspi_flash_session_t *s, uint32_t address,
+                                  const void *data, uint32_t len)
+{
+    const qspi_job_seg_t seg = { address, data, len };
 
-    // 3) ERASE all touched sectors
-    uint32_t start = address & ~(SST26_SECTOR_SIZE - 1U);
-    uint32_t end   = (address + total_len + (SST26_SECTOR_SIZE - 1U)) & ~(SST26_SECTOR_SIZE - 1U);
+    if (QSPI_Job_IsBusy())
+        (void)QSPI_Job_Wait();
+    if (!QSPI_Job_Write(0U, 0U, &seg, 1U, true, NULL, NULL) || !QSPI_Job_Wait())
+    {
+        printf("[QSPI] session @0x%06lX: program at 0x%06lX failed\r\n",
+               (unsigned long)s->address, (unsigned long)address);
+        s->failed = true;
+        return false;
+    }
+    return true;
+}
+
+bool QSPI_Flash_WriteBegin(qspi_flash_session_t *s, uint32_t address, uint32_t max_len,
+                           uint32_t type_id, uint32_t version)
+{
+    const qspi_flash_ops_t *ops = QSPI_Flash_Ops();
+    const uint32_t total_len = (uint32_t)sizeof(qspi_obj_hdr_t) + max_len;
+
+    if ((s == NULL) || (max_len == 0U) || (ops == NULL) ||
+        (ops->page_size > QSPI_FLASH_SESSION_BUF) || flash_reserved(address, total_len))
+        return false;
 
-    for (uint32_t a = start; a < end; a += SST26_SECTOR_SIZE)
+    memset(s, 0, sizeof(*s));
+    s->address  = address;
+    s->max_len  = max_len;
+    s->type_id  = type_id;
+    s->version  = version;
+    s->prog     = address + (uint32_t)sizeof(qspi_obj_hdr_t);
+    s->page     = ops->page_size;
+#if QSPI_FLASH_TIMELOG
+    s->t_start_ms = millis();
+#endif
+
+#if QSPI_FLASH_INDEX
+    QSPI_Index_RemoveRange(&s_index, address, total_len, (uint32_t)sizeof(qspi_obj_hdr_t));
+#endif
+    if (QSPI_Job_IsBusy())
+        (void)QSPI_Job_Wait();
+    if (!QSPI_Job_Write(address, total_len, NULL, 0U, false, NULL, NULL) || !QSPI_Job_Wait())
+        return false;
+
+    s->open = true;
+    return true;
+}
+
+bool QSPI_Flash_WriteAppend(qspi_flash_session_t *s, const void *data, uint32_t len)
+{
+    const uint8_t *p = (const uint8_t *)data;
+
+    if ((s == NULL) || !s->open || s->failed || ((len != 0U) && (data == NULL)) ||
+        (len > (s->max_len - s->len)))
+        return false;
+
+    s->crc  = QSPI_CRC32_Update(s->crc, p, len);
+    s->len += len;
+
+    while (len != 0U)
     {
-        if (!SST26_SectorErase(a))
-            goto out;
+        /* the buffer holds [prog, prog + fill), never across a page boundary */
+        uint32_t room = s->page - ((s->prog + s->fill) % s->page);
+        uint32_t n = (len < room) ? len : room;
 
-        if (!SST26_WaitWhileBusy(SST26_FT_SECTOR_ERASE_LOOPS))
-            goto out;
+        memcpy(&s->buf[s->fill], p, n);
+        s->fill += n;
+        p   += n;
+        len -= n;
+
+        if (n == room)
+        {
+            if (!flash_session_program(s, s->prog, s->buf, s->fill))
+                return false;
+            s->prog += s->fill;
+            s->fill  = 0U;
+        }
     }
+    return true;
+}
 
-    // 4) Program header
-    if (!flash_write_pages(address, (const uint8_t *)&hdr, (uint32_t)sizeof(hdr)))
-        goto out;
+bool QSPI_Flash_WriteCommit(qspi_flash_session_t *s)
+{
+    bool ok = false;
+    qspi_obj_hdr_t hdr;
 
-    // 5) Program payload
-    if (!flash_write_pages(address + (uint32_t)sizeof(hdr), (const uint8_t *)obj, obj_len))
-        goto out;
+    if ((s == NULL) || !s->open)
+        return false;
 
-    // 6) Verify
-    if (!flash_verify(address, &hdr, (uint32_t)sizeof(hdr)))
-        goto out;
+    if (!s->failed && (s->len != 0U) &&
+        ((s->fill == 0U) || flash_session_program(s, s->prog, s->buf, s->fill)))
+    {
+        /* header last: the object exists from here on */
+        flash_obj_hdr_build(&hdr, s->type_id, s->version, s->len, s->crc);
+        ok = flash_session_program(s, s->address, &hdr, (uint32_t)sizeof(hdr));
+    }
+#if QSPI_FLASH_INDEX
+    if (ok)
+        flash_index_put(s->address, &hdr);
+#endif
+    s->open = false;
 
-    if (!flash_verify(address + (uint32_t)sizeof(hdr), obj, obj_len))
-        goto out;
+#if QSPI_FLASH_TIMELOG
+    qspi_timelog_print("WriteSession", ok, s->t_start_ms, s->address, s->len);
+#endif
+    return ok;
+}
 
-    ok = true;
+void QSPI_Flash_WriteAbort(qspi_flash_session_t *s)
+{
+    if (s != NULL)
+        s->open = false;        /* no header was programmed: nothing to undo */
+}
 
-out:
+
+/*
+ * QSPI_Flash_EraseRange()
+ * ----------------------
+ * Erases [address, address + len) rounded out to sectors (partition wipe).
+ * The erase planner covers the range with the fewest block/sector erases.
+ */
+bool QSPI_Flash_EraseRange(uint32_t address, uint32_t len)
+{
 #if QSPI_FLASH_TIMELOG
-    qspi_timelog_print("Write", ok, t_start_ms, address, obj_len);
+    uint32_t t_start_ms = millis();
+#endif
+    bool ok = g_qspi_jedec_valid && (len != 0U) && !flash_reserved(address, len);
+
+    if (ok && QSPI_Job_IsBusy())
+        (void)QSPI_Job_Wait();
+    ok = ok && QSPI_Job_Write(address, len, NULL, 0U, false, NULL, NULL) &&
+         QSPI_Job_Wait();
+
+#if QSPI_FLASH_TIMELOG
+    qspi_timelog_print("Erase", ok, t_start_ms, address, len);
 #endif
     return ok;
 }
 
-
 /*
  * QSPI_Flash_WriteSector()
  * -----------------------
@@ -392,10 +947,141 @@ bool QSPI_Flash_WriteSector(int sector,
     if ((uint32_t)sector >= QSPI_OBJ_MAX_SECTORS)
         return false;
 
-    uint32_t addr = QSPI_OBJ_STORE_BASE + ((uint32_t)sector * SST26_SECTOR_SIZE);
+    uint32_t addr = QSPI_OBJ_STORE_BASE + ((uint32_t)sector * QSPI_OBJ_SECTOR_SIZE);
     return QSPI_Flash_WriteAddr(addr, obj, obj_len, type_id, version);
 }
 
+#if QSPI_FLASH_INDEX
+bool QSPI_Flash_Lookup(uint32_t type_id, uint32_t *address_out,
+                       uint32_t *len_out, uint32_t *version_out)
+{
+    const qspi_index_entry_t *e = g_qspi_jedec_valid ? QSPI_Index_Get(&s_index, type_id) : NULL;
+
+    if (e == NULL)
+        return false;
+    if (address_out != NULL)
+        *address_out = e->address;
+    if (len_out != NULL)
+        *len_out = e->len;
+    if (version_out != NULL)
+        *version_out = e->version;
+    return true;
+}
+
+bool QSPI_Flash_ReadType(uint32_t type_id,
+                         void *obj_out, uint32_t obj_max_len,
+                         qspi_obj_hdr_t *hdr_out,
+                         bool verify_crc)
+{
+    uint32_t addr;
+
+    if (!QSPI_Flash_Lookup(type_id, &addr, NULL, NULL))
+        return false;
+    return QSPI_Flash_ReadAddr(addr, obj_out, obj_max_len, hdr_out, verify_crc);
+}
+
+static bool flash_view_sink(const void *chunk, uint32_t offset, uint32_t len, void *ctx)
+{
+    (void)chunk;
+    (void)offset;
+    (void)len;
+    (void)ctx;
+    return true;
+}
+
+/* Full check of an indexed object: header, then the payload CRC */
+static bool flash_view_verify(const qspi_index_entry_t *e)
+{
+    qspi_obj_hdr_t hdr;
+    uint8_t buf[64] __attribute__((aligned(4)));
+    uint32_t crc = 0U;
+
+    return QSPI_Flash_ReadData(e->address, &hdr, (uint32_t)sizeof(hdr), NULL) &&
+           flash_hdr_valid(hdr) && (hdr.type_id == e->type_id) && (hdr.payload_len == e->len) &&
+           QSPI_Flash_ReadDataStream(e->address + (uint32_t)sizeof(hdr), hdr.payload_len,
+                                     buf, (uint32_t)sizeof(buf), flash_view_sink, NULL, &crc) &&
+           (crc == hdr.payload_crc);
+}
+
+/*
+ * QSPI_Flash_ViewBegin()
+ * ----------------------
+ * Zero-copy access: view->data points at the payload in the QSPI AHB window.
+ * The first view of an object reads it once to check header and payload
+ * CRC; the verdict is kept in its index entry, which any rewrite or erase
+ * replaces, so later views cost an index probe and one short read.
+ *
+ * The window decodes CPU reads with the last read frame, so that read is
+ * issued here (at the object, which also selects its scrambler setting),
+ * and a background job is suspended until QSPI_Flash_ViewEnd(). Keep the
+ * bracket short and do not call other QSPI functions inside it.
+ */
+bool QSPI_Flash_ViewBegin(uint32_t type_id, qspi_flash_view_t *view)
+{
+    const qspi_index_entry_t *e = g_qspi_jedec_valid ? QSPI_Index_Get(&s_index, type_id) : NULL;
+    uint32_t probe;
+
+    if ((view == NULL) || (e == NULL))
+        return false;
+
+    qspi_index_entry_t ent = *e;
+    if ((ent.flags & QSPI_INDEX_F_VERIFIED) == 0U)
+    {
+        s_view_verifies++;
+        if (!flash_view_verify(&ent))
+        {
+            printf("[QSPI] view: type %lu @0x%06lX failed its check\r\n",
+                   (unsigned long)type_id, (unsigned long)ent.address);
+            return false;
+        }
+        ent.flags |= QSPI_INDEX_F_VERIFIED;
+        (void)QSPI_Index_Put(&s_index, &ent);
+    }
+
+    if (!QSPI_Job_Suspend(ent.address, (uint32_t)sizeof(qspi_obj_hdr_t) + ent.len))
+        return false;
+#if QSPI_CACHE_ENABLE
+    /* a hit in the read cache would leave the window unarmed */
+    if (!QSPI_Cache_ReadThrough(&probe, (uint32_t)sizeof(probe), ent.address))
+#else
+    if (!s_ops->read(&probe, (uint32_t)sizeof(probe), ent.address))
+#endif
+    {
+        QSPI_Job_Resume();
+        return false;
+    }
+
+    /* the CMCC may still hold lines of what was there before */
+    if (s_view_stale)
+    {
+        CPU_CacheInvalidate();
+        s_view_stale = false;
+    }
+
+    view->data    = (const void *)(QSPI_ADDR + ent.address + (uint32_t)sizeof(qspi_obj_hdr_t));
+    view->len     = ent.len;
+    view->version = ent.version;
+    view->address = ent.address;
+    s_view_count++;
+    return true;
+}
+
+void QSPI_Flash_ViewEnd(qspi_flash_view_t *view)
+{
+    if (view == NULL)
+        return;
+    view->data = NULL;
+    QSPI_Job_Resume();
+}
+
+/* An erase destroys every object it touches, header or payload */
+void QSPI_Flash_NoteErase(uint32_t addr, uint32_t len)
+{
+    s_view_stale = true;
+    QSPI_Index_RemoveRange(&s_index, addr, len, (uint32_t)sizeof(qspi_obj_hdr_t));
+}
+#endif
+
 
 static const char *qspi_width_str(uint32_t width)
 {
@@ -485,6 +1171,114 @@ void QSPI_Flash_Diag_Print(void)
 
     printf("Flash Detected  : %s\r\n",
           g_qspi_jedec_valid ? "VALID" : "INVALID");
+    printf("Flash Part      : %s\r\n",
+          (s_ops != NULL) ? s_ops->name : "-");
+    if (s_ops != NULL)
+    {
+        printf("Flash Geometry  : %lu KB, sector %lu, page %lu\r\n",
+              (unsigned long)(s_ops->capacity / 1024UL),
+              (unsigned long)s_ops->sector_size,
+              (unsigned long)s_ops->page_size);
+    }
+#if QSPI_FLASH_SFDP
+    QSPI_SFDP_Print(&s_sfdp);
+#endif
+
+#if QSPI_FLASH_SCRAMBLE
+    printf("Scrambling      : 0x%06lX..0x%06lX%s\r\n",
+          (unsigned long)QSPI_FLASH_SCRAMBLE_BASE,
+          (unsigned long)(QSPI_FLASH_SCRAMBLE_BASE + QSPI_FLASH_SCRAMBLE_SIZE - 1UL),
+          QSPI_HW_Scramble_IsEnabled() ? "" : " (NOT ACTIVE)");
+#else
+    printf("Scrambling      : OFF\r\n");
+#endif
+
+#if QSPI_HW_STATS
+    qspi_hw_stats_t st;
+    const uint32_t cyc_per_us = (uint32_t)(CPU_CLOCK_HZ / 1000000UL);
+    QSPI_HW_Stats_Get(&st);
+
+    printf("---- Bus statistics ----\r\n");
+    for (uint32_t i = 0; i < (uint32_t)QSPI_INSTR_TYPE_COUNT; i++)
+    {
+        printf("  %-10s    : %lu\r\n",
+               QSPI_HW_Stats_InstrName((qspi_instr_type_t)i),
+               (unsigned long)st.instr[i]);
+    }
+    printf("  Bytes read    : %lu KB\r\n", (unsigned long)(st.bytes_read / 1024ULL));
+    printf("  Bytes written : %lu KB\r\n", (unsigned long)(st.bytes_written / 1024ULL));
+    printf("  INSTREND wait : %lu us (%lu timeouts)\r\n",
+           (unsigned long)(st.instrend_cycles / cyc_per_us),
+           (unsigned long)st.instrend_timeouts);
+    printf("  Busy polling  : %lu us in %lu waits, %lu status reads\r\n",
+           (unsigned long)(st.busy_cycles / cyc_per_us),
+           (unsigned long)st.busy_waits,
+           (unsigned long)st.busy_polls);
+    for (uint32_t i = 0; i < (uint32_t)QSPI_BUSY_OP_COUNT; i++)
+    {
+        const qspi_busy_op_stats_t *o = &st.busy_op[i];
+        if ((o->count == 0U) && (o->timeouts == 0U))
+            continue;
+        printf("  %-10s    : %lu x, avg %lu us (min %lu, max %lu, last %lu), %lu timeouts\r\n",
+               QSPI_HW_Stats_BusyOpName((qspi_busy_op_t)i),
+               (unsigned long)o->count,
+               (unsigned long)((o->count != 0U) ? (o->total_us / o->count) : 0U),
+               (unsigned long)o->min_us,
+               (unsigned long)o->max_us,
+               (unsigned long)o->last_us,
+               (unsigned long)o->timeouts);
+    }
+#endif
+
+    {
+        qspi_job_stats_t js;
+        QSPI_Job_GetStats(&js);
+        printf("---- Flash jobs ----\r\n");
+        printf("  Suspends      : %lu (max %lu us, %lu held off)\r\n",
+               (unsigned long)js.suspends,
+               (unsigned long)(js.max_suspend_cycles / (uint32_t)(CPU_CLOCK_HZ / 1000000UL)),
+               (unsigned long)js.resume_holdoffs);
+        printf("  Read conflicts: %lu\r\n", (unsigned long)js.conflicts);
+        printf("  Erases        : %lu block, %lu sector, %lu skipped\r\n",
+               (unsigned long)js.block_erases,
+               (unsigned long)js.sector_erases,
+               (unsigned long)js.erase_skips);
+    }
+
+#if QSPI_CRC_HW
+    {
+        qspi_crc_hw_stats_t cs;
+        QSPI_CRC_HW_GetStats(&cs);
+        printf("---- CRC32 ----\r\n");
+        printf("  Engines       : DSU %s, DMAC %s\r\n",
+               cs.dsu ? "ON" : "OFF", cs.dmac ? "ON" : "OFF");
+        printf("  Bytes         : DMAC %lu, DSU %lu, CPU %lu (%lu engine errors)\r\n",
+               (unsigned long)cs.dmac_bytes, (unsigned long)cs.dsu_bytes,
+               (unsigned long)cs.sw_bytes, (unsigned long)cs.errors);
+    }
+#endif
+
+#if QSPI_FLASH_INDEX
+    printf("---- Object index ----\r\n");
+    printf("  Objects       : %lu of %lu slots (max probe %lu, %lu duplicates, %lu dropped)\r\n",
+           (unsigned long)s_index.count, (unsigned long)QSPI_FLASH_INDEX_SLOTS,
+           (unsigned long)s_index.probes_max, (unsigned long)s_index_dups,
+           (unsigned long)s_index.dropped);
+    printf("  Views         : %lu (%lu full checks)\r\n",
+           (unsigned long)s_view_count, (unsigned long)s_view_verifies);
+#endif
+
+#if QSPI_CACHE_ENABLE
+    QSPI_Cache_Print();
+#endif
+
+#if QSPI_WEAR_ENABLE
+    QSPI_Wear_Print();
+#endif
+
+#if QSPI_LOG_ENABLE
+    QSPI_Log_Print();
+#endif
 
     printf("=================================================\r\n");
 }
@@ -517,13 +1311,24 @@ static void DeviceCfg_Log(const char *tag, const device_cfg_t *cfg)
             (unsigned)cfg->flags
         );
 }
+
+/* Streaming read sink: a payload too large for RAM would be parsed or
+ * copied on here; the example only counts what arrives */
+static bool DeviceCfg_StreamChunk(const void *chunk, uint32_t offset, uint32_t len, void *ctx)
+{
+    (void)chunk;
+    (void)offset;
+    *(uint32_t *)ctx += len;
+    return true;
+}
+
 void QSPI_FLASH_Example_WriteRead(void)
 {
     #define QSPI_CFG_FLASH_ADDR   (8U * 4096U)   // sector 8
     bool ok;
     
-    if(!SST26_ChipErase(0)){
-        printf("[SST26] Chip erase FAILED\r\n");
+    if (!QSPI_Job_ChipErase(NULL, NULL) || !QSPI_Job_Wait()){
+        printf("[QSPI] Chip erase FAILED\r\n");
     }
     
     // Initialize data cfg
@@ -554,6 +1359,15 @@ void QSPI_FLASH_Example_WriteRead(void)
     device_cfg_t cfg_read;
     qspi_obj_hdr_t meta;
 
+#if QSPI_FLASH_INDEX
+    ok = QSPI_Flash_ReadType(
+                1,     // type_id: address comes from the index
+                &cfg_read,
+                (uint32_t)sizeof(cfg_read),
+                &meta,
+                true   // verify payload CRC
+              );
+#else
     ok = QSPI_Flash_ReadAddr(
                 QSPI_CFG_FLASH_ADDR,
                 &cfg_read,
@@ -561,6 +1375,7 @@ void QSPI_FLASH_Example_WriteRead(void)
                 &meta,
                 true   // verify payload CRC
               );
+#endif
 
     if (!ok)
     {
@@ -579,6 +1394,72 @@ void QSPI_FLASH_Example_WriteRead(void)
                   (unsigned)cfg_read.flags);
         DeviceCfg_Log("READ", &cfg_read);
     }
+
+#if QSPI_CACHE_ENABLE && QSPI_FLASH_INDEX
+    /* Read it again: header and payload now come from the SRAM read cache */
+    qspi_cache_stats_t cs0, cs1;
+    QSPI_Cache_GetStats(&cs0);
+    ok = QSPI_Flash_ReadType(1U, &cfg_read, (uint32_t)sizeof(cfg_read), NULL, true);
+    QSPI_Cache_GetStats(&cs1);
+    printf("[QSPI] Config re-read %s: %lu cache hits, %lu misses\r\n",
+           ok ? "OK" : "FAILED",
+           (unsigned long)(cs1.hits - cs0.hits), (unsigned long)(cs1.misses - cs0.misses));
+#endif
+
+    /* Same object in 8-byte chunks: RAM use is the chunk buffer only */
+    uint8_t chunk[8] __attribute__((aligned(4)));
+    uint32_t streamed = 0U;
+    ok = QSPI_Flash_ReadStream(QSPI_CFG_FLASH_ADDR, chunk, (uint32_t)sizeof(chunk),
+                               DeviceCfg_StreamChunk, &streamed, NULL, true);
+    printf("[QSPI] Config stream %s: %lu bytes in %lu B chunks, CRC checked\r\n",
+           ok ? "OK" : "FAILED", (unsigned long)streamed, (unsigned long)sizeof(chunk));
+
+    /* Written the other way round: payload in pieces (as it would come from
+     * UART RX), header last */
+    static qspi_flash_session_t ws;
+    const uint8_t *src = (const uint8_t *)&cfg;
+    ok = QSPI_Flash_WriteBegin(&ws, QSPI_CFG_FLASH_ADDR + 4096U, (uint32_t)sizeof(cfg), 2U, 1U) &&
+         QSPI_Flash_WriteAppend(&ws, src, 5U) &&
+         QSPI_Flash_WriteAppend(&ws, src + 5U, (uint32_t)sizeof(cfg) - 5U) &&
+         QSPI_Flash_WriteCommit(&ws);
+    ok = ok && QSPI_Flash_ReadAddr(QSPI_CFG_FLASH_ADDR + 4096U, &cfg_read,
+                                   (uint32_t)sizeof(cfg_read), &meta, true) &&
+         (memcmp(&cfg_read, &cfg, sizeof(cfg)) == 0);
+    printf("[QSPI] Config session write %s\r\n", ok ? "OK" : "FAILED");
+
+#if QSPI_FLASH_INDEX
+    /* Read in place: the payload is used straight from the QSPI window */
+    qspi_flash_view_t view;
+    if (QSPI_Flash_ViewBegin(2U, &view))
+    {
+        ok = (view.len == (uint32_t)sizeof(cfg)) && (memcmp(view.data, &cfg, sizeof(cfg)) == 0);
+        QSPI_Flash_ViewEnd(&view);
+    }
+    else
+    {
+        ok = false;
+    }
+    printf("[QSPI] Config view %s\r\n", ok ? "OK" : "FAILED");
+#endif
+
+#if QSPI_LOG_ENABLE
+    /* Same config through the log store: updates append, nothing is erased */
+    qspi_job_stats_t js0, js1;
+    QSPI_Job_GetStats(&js0);
+
+    cfg.boot_count++;
+    ok = QSPI_Log_Write(1U, 1U, &cfg, (uint32_t)sizeof(cfg));
+    cfg.boot_count++;
+    ok = ok && QSPI_Log_Write(1U, 1U, &cfg, (uint32_t)sizeof(cfg));
+    ok = ok && QSPI_Log_Read(1U, &cfg_read, (uint32_t)sizeof(cfg_read), NULL, NULL);
+
+    QSPI_Job_GetStats(&js1);
+    printf("[QSPI_LOG] 2 updates %s: boot=%lu, %lu erases\r\n",
+           ok ? "OK" : "FAILED",
+           (unsigned long)cfg_read.boot_count,
+           (unsigned long)((js1.sector_erases + js1.block_erases) -
+                           (js0.sector_erases + js0.block_erases)));
+#endif
 }
 
 
@@ -3,6 +3,9 @@
 #define QSPI_FLASH_H
 
 #include <stdbool.h>
+#include <stdint.h>
+#include "qspi_flash_ops.h"
+#include "qspi_job.h"
 typedef struct __attribute__((packed))
 {
     uint32_t magic;
@@ -15,11 +18,12 @@ typedef struct __attribute__((packed))
     uint32_t header_crc;
 } qspi_obj_hdr_t;
 
+/* Flash drivers linked into the image; the JEDEC ID selects one at init */
 #define APP_USE_SST26_FLASH  1
-#define APP_USE_N25Q_FLASH   0
+#define APP_USE_N25Q_FLASH   1
 
-#if (APP_USE_SST26_FLASH + APP_USE_N25Q_FLASH) != 1
-#error "Select exactly one flash type"
+#if (APP_USE_SST26_FLASH + APP_USE_N25Q_FLASH) == 0
+#error "Enable at least one flash driver"
 #endif
 
 
@@ -28,16 +32,64 @@ typedef struct __attribute__((packed))
 #define QSPI_OBJ_MAGIC            (0x314A424FUL) // 'OBJ1' (example)
 #define QSPI_OBJ_STORE_BASE       (0x000000UL)   // flash offset base for your objects region
 #define QSPI_OBJ_MAX_SECTORS      (256U)         // cap safety (example)
+#define QSPI_OBJ_SECTOR_SIZE      (4096UL)       // object slot = 4K erase unit on both parts
+
+/* 1 = index the object store by type_id at init (QSPI_Flash_Lookup/ReadType).
+ * Slots must be a power of two; 3/4 of them can be used. */
+#define QSPI_FLASH_INDEX          1
+#define QSPI_FLASH_INDEX_SLOTS    (64U)
+
+/* Write session buffer: one flash page (page_size must not exceed it) */
+#define QSPI_FLASH_SESSION_BUF    (256U)
+
+/* 1 = read JEDEC SFDP at init: geometry (capacity, erase/page size) comes from
+ * the BFPT, and a part with no dedicated driver runs on the generic SFDP
+ * driver (fastest 1-x-x read it advertises). 0 = driver constants only. */
+#define QSPI_FLASH_SFDP           1
+
+/* 1 = object reads use continuous read (mode byte latches the opcode) */
+#define QSPI_FLASH_CONT_READ      1
+
+/* 1 = object store region is scrambled by the QSPI (SCRAMBCTRL/SCRAMBKEY).
+ * Data at rest is obfuscated; reads through the driver return clear data.
+ * Changing the key (or CHIP_UNIQUE) makes existing objects unreadable. */
+#define QSPI_FLASH_SCRAMBLE              0
+#define QSPI_FLASH_SCRAMBLE_KEY          (0x5A3C96E1UL)
+#define QSPI_FLASH_SCRAMBLE_BASE         QSPI_OBJ_STORE_BASE
+#define QSPI_FLASH_SCRAMBLE_SIZE         ((uint32_t)QSPI_OBJ_MAX_SECTORS * QSPI_OBJ_SECTOR_SIZE)
+#define QSPI_FLASH_SCRAMBLE_CHIP_UNIQUE  0    /* 1 = also bind to this MCU */
+
+/* 1 = run the QSPI benchmark matrix (qspi_bench.c) at boot.
+ * DESTRUCTIVE for QSPI_BENCH_ADDR..+QSPI_BENCH_SIZE. */
+#define QSPI_FLASH_BENCH          0
 
 #define QSPI_FLASH_TIMELOG      1
 #if QSPI_FLASH_TIMELOG == 1
     #define QSPI_FLASH_TIMELOG_FLOAT    1
 #endif
 bool QSPI_Flash_Init(void);
+/* Ops table of the detected part, NULL until QSPI_Flash_Init() succeeded */
+const qspi_flash_ops_t *QSPI_Flash_Ops(void);
 bool QSPI_Flash_ReadAddr(uint32_t address,
                          void *obj_out, uint32_t obj_max_len,
                          qspi_obj_hdr_t *hdr_out,
                          bool verify_crc);
+/* Raw read (no object header); crc_out optional */
+bool QSPI_Flash_ReadData(uint32_t address, void *dst, uint32_t len, uint32_t *crc_out);
+/* Streaming reads: cb gets each chunk (buf, buf_len bytes at most) with its
+ * payload offset; false from cb stops the read. Only buf is needed in RAM. */
+typedef bool (*qspi_flash_chunk_cb_t)(const void *chunk, uint32_t offset, uint32_t len, void *ctx);
+/* crc_inout optional: running CRC32, 0 to start */
+bool QSPI_Flash_ReadDataStream(uint32_t address, uint32_t len,
+                               void *buf, uint32_t buf_len,
+                               qspi_flash_chunk_cb_t cb, void *ctx,
+                               uint32_t *crc_inout);
+/* Object read in chunks; the CRC verdict comes after the last chunk */
+bool QSPI_Flash_ReadStream(uint32_t address,
+                           void *buf, uint32_t buf_len,
+                           qspi_flash_chunk_cb_t cb, void *ctx,
+                           qspi_obj_hdr_t *hdr_out,
+                           bool verify_crc);
 bool QSPI_Flash_ReadSector(int sector,
                            void *obj_out, uint32_t obj_max_len,
                            qspi_obj_hdr_t *hdr_out,
@@ -45,9 +97,72 @@ bool QSPI_Flash_ReadSector(int sector,
 bool QSPI_Flash_WriteAddr(uint32_t address,
                           const void *obj, uint32_t obj_len,
                           uint32_t type_id, uint32_t version);
+/* Non-blocking write: queued on the job engine, result through cb */
+bool QSPI_Flash_WriteAddrAsync(uint32_t address,
+                               const void *obj, uint32_t obj_len,
+                               uint32_t type_id, uint32_t version,
+                               qspi_job_cb_t cb, void *ctx);
+/*
+ * Write session: an object whose payload arrives in chunks. Only one page
+ * of it is buffered; the header goes out last, so the object appears on
+ * Commit (or not at all). Caller-owned, one per object being written.
+ */
+typedef struct
+{
+    uint32_t address;           /* object header */
+    uint32_t max_len;           /* payload bytes erased for */
+    uint32_t type_id;
+    uint32_t version;
+    uint32_t len;               /* payload bytes appended */
+    uint32_t crc;               /* running payload CRC */
+    uint32_t prog;              /* flash address of buf[0] */
+    uint32_t fill;              /* bytes in buf */
+    uint32_t page;
+    uint32_t t_start_ms;
+    bool     open;
+    bool     failed;
+    uint8_t  buf[QSPI_FLASH_SESSION_BUF] __attribute__((aligned(4)));
+} qspi_flash_session_t;
+
+/* Erase room for max_len payload bytes at address (blocking) */
+bool QSPI_Flash_WriteBegin(qspi_flash_session_t *s, uint32_t address, uint32_t max_len,
+                           uint32_t type_id, uint32_t version);
+/* Programs each page as it fills (blocking per page) */
+bool QSPI_Flash_WriteAppend(qspi_flash_session_t *s, const void *data, uint32_t len);
+/* Last partial page, then the header; the index is updated */
+bool QSPI_Flash_WriteCommit(qspi_flash_session_t *s);
+void QSPI_Flash_WriteAbort(qspi_flash_session_t *s);
+/* Erase a range (block erases where possible); blocking via the job engine */
+bool QSPI_Flash_EraseRange(uint32_t address, uint32_t len);
 bool QSPI_Flash_WriteSector(int sector,
                             const void *obj, uint32_t obj_len,
                             uint32_t type_id, uint32_t version);
+#if QSPI_FLASH_INDEX
+/* Location of the object of type_id (from the RAM index, no flash access) */
+bool QSPI_Flash_Lookup(uint32_t type_id, uint32_t *address_out,
+                       uint32_t *len_out, uint32_t *version_out);
+/* QSPI_Flash_ReadAddr() at the indexed address of type_id */
+bool QSPI_Flash_ReadType(uint32_t type_id,
+                         void *obj_out, uint32_t obj_max_len,
+                         qspi_obj_hdr_t *hdr_out,
+                         bool verify_crc);
+/* Job engine hook: [addr, addr + len) was erased */
+void QSPI_Flash_NoteErase(uint32_t addr, uint32_t len);
+
+/* Zero-copy view of an object's payload in the memory-mapped QSPI window */
+typedef struct
+{
+    const void *data;           /* valid between ViewBegin and ViewEnd */
+    uint32_t    len;
+    uint32_t    version;
+    uint32_t    address;        /* object header */
+} qspi_flash_view_t;
+
+/* Header + CRC are checked on the first view only (until rewritten).
+ * A running job is suspended until ViewEnd: keep the bracket short. */
+bool QSPI_Flash_ViewBegin(uint32_t type_id, qspi_flash_view_t *view);
+void QSPI_Flash_ViewEnd(qspi_flash_view_t *view);
+#endif
 void QSPI_Flash_Diag_Print(void);
 void QSPI_FLASH_Example_WriteRead(void);
 
@@ -0,0 +1,67 @@
+/* qspi_flash_ops.h: Flash device operations table
+ *
+ * Each flash driver (sst26/, n25q/) exports one constant table. QSPI_Flash_Init()
+ * reads the JEDEC ID and selects the matching table, and qspi_flash.c only calls
+ * through it, so one image runs on both Xplained Pro board revisions.
+ *
+ * Conventions:
+ *  - program/erase only issue the command; callers then use wait_ready()
+ *    or poll read_status() (bit0 = WIP on every supported part), no sooner
+ *    than timing[op].typ_us and for at most timing[op].max_us
+ *  - program never crosses page_size (caller splits)
+ *  - addresses are flash offsets (0..capacity-1)
+ */
+
+#ifndef QSPI_FLASH_OPS_H
+#define QSPI_FLASH_OPS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "qspi_hw.h"
+
+typedef struct
+{
+    const char *name;
+    uint32_t    jedec_id;           /* byte0 = manufacturer (as read from 9Fh) */
+    uint32_t    capacity;           /* addressable bytes */
+    uint32_t    sector_size;        /* smallest erase unit */
+    uint32_t    page_size;          /* program page */
+
+    /* Datasheet typ/max per operation, indexed by qspi_busy_op_t */
+    const qspi_busy_timing_t *timing;
+
+    /* Reset + protocol/quad setup + unprotect. The QSPI is already enabled. */
+    bool (*init)(void);
+    bool (*quad_enable)(void);
+    bool (*read_jedec)(uint32_t *jedec_out);
+    bool (*read_status)(uint8_t *sr_out);
+    /* Blocking QSPI_HW_WaitReady() with timing[op] */
+    bool (*wait_ready)(qspi_busy_op_t op);
+
+    bool (*read)(void *rx, uint32_t len, uint32_t address);
+    /* Fastest read path (continuous read / XIP); NULL if not supported */
+    bool (*read_cont)(void *rx, uint32_t len, uint32_t address);
+
+    bool (*program)(const void *tx, uint32_t len, uint32_t address);
+    bool (*erase_sector)(uint32_t address);
+
+    /* Block erase for the erase planner (NULL = sector erase only).
+     * block_fit() returns the largest block that starts at address and ends
+     * inside [address, address + len), or 0 if none is larger than
+     * sector_size; erase_block() erases that block. */
+    uint32_t (*block_fit)(uint32_t address, uint32_t len);
+    bool (*erase_block)(uint32_t address, uint32_t size);
+    /* Blocking; uses the driver's own timeout */
+    bool (*chip_erase)(void);
+    /* WREN + chip erase opcode only; caller polls read_status() (WIP, bit0) */
+    bool (*chip_erase_start)(void);
+
+    /* Suspend an in-flight sector erase / page program and return once reads
+     * are allowed (true as well when nothing was in progress); resume()
+     * continues it. NULL if the part has no suspend. */
+    bool (*suspend)(void);
+    bool (*resume)(void);
+} qspi_flash_ops_t;
+
+#endif /* QSPI_FLASH_OPS_H */
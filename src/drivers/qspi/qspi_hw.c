@@ -7,15 +7,35 @@
  *  - Wait for INTFLAG.INSTREND and clear it
  */
 
+#include <string.h>
 #include "qspi_hw.h"
-//#include "../../common/board.h"
+#include "../../common/board.h"
+
+#if QSPI_HW_STATS
+static qspi_hw_stats_t s_stats;
+
+#define QSPI_STAT_INSTR(t)          (s_stats.instr[(t)]++)
+#define QSPI_STAT_ADD(field, n)     (s_stats.field += (n))
+#define QSPI_STAT_CYC_START()       uint32_t stat_c0_ = DWT->CYCCNT
+#define QSPI_STAT_CYC_END()         (s_stats.instrend_cycles += (uint32_t)(DWT->CYCCNT - stat_c0_))
+#else
+#define QSPI_STAT_INSTR(t)          ((void)0)
+#define QSPI_STAT_ADD(field, n)     ((void)0)
+#define QSPI_STAT_CYC_START()       ((void)0)
+#define QSPI_STAT_CYC_END()         ((void)0)
+#endif
 
 static inline bool qspi_wait_instrend_clear(void)
 {
     uint32_t guard = 2000000UL;
+    QSPI_STAT_CYC_START();
     while (((QSPI_REGS->QSPI_INTFLAG & QSPI_INTFLAG_INSTREND_Msk) == 0U) && (guard-- != 0U)) { }
+    QSPI_STAT_CYC_END();
     if (guard == 0U)
+    {
+        QSPI_STAT_ADD(instrend_timeouts, 1U);
         return false;
+    }
 
     /* Harmony clears AFTER observe */
     QSPI_REGS->QSPI_INTFLAG = QSPI_INTFLAG_INSTREND_Msk;
@@ -26,12 +46,89 @@ static inline bool qspi_wait_instrend_clear(void)
 /* AHB aperture base (device-pack symbol) */
 static volatile uint8_t * const QSPI_MEM8 = (volatile uint8_t *)QSPI_ADDR;
 
+/* Continuous-read state: once the flash has latched the read opcode (mode byte
+ * accepted), every other instruction must first take it out of that mode. */
+static qspi_cont_read_cfg_t s_cr_cfg;
+static bool     s_cr_active = false;
+static uint32_t s_cr_last_addr = 0U;
+
+static bool qspi_cr_exit_if_active(void);
+
+/* Optional AHB-window copy routine for memory reads (NULL = byte loop) */
+static qspi_read_copy_t s_read_copy = NULL;
+
+/* Scrambled partition (SCRAMBCTRL is switched per memory frame) */
+#define QSPI_SCRAMBLE_ALIGN     (4096UL)
+
+static bool     s_scr_enabled = false;
+static uint32_t s_scr_base = 0U;
+static uint32_t s_scr_size = 0U;
+static uint32_t s_scr_ctrl = 0U;        /* ENABLE | RANDOMDIS when in range */
+static uint32_t s_scr_ctrl_cur = 0U;    /* last value written to SCRAMBCTRL */
+
+static inline bool qspi_scr_covers(uint32_t address)
+{
+    return s_scr_enabled && ((address - s_scr_base) < s_scr_size);
+}
+
+static inline void qspi_scr_apply(uint32_t address)
+{
+    uint32_t ctrl = qspi_scr_covers(address) ? s_scr_ctrl : 0U;
+    if (ctrl != s_scr_ctrl_cur)
+    {
+        QSPI_REGS->QSPI_SCRAMBCTRL = ctrl;
+        s_scr_ctrl_cur = ctrl;
+    }
+}
+
+/* Register commands (status, IDs, ...) always run unscrambled */
+static inline void qspi_scr_off(void)
+{
+    if (s_scr_ctrl_cur != 0U)
+    {
+        QSPI_REGS->QSPI_SCRAMBCTRL = 0U;
+        s_scr_ctrl_cur = 0U;
+    }
+}
+
+/* Bytes from address (max len) that share the same scrambling state */
+static size_t qspi_scr_span(uint32_t address, size_t len)
+{
+    if (!s_scr_enabled)
+        return len;
+
+    uint32_t edge;
+    if (address < s_scr_base)
+        edge = s_scr_base;
+    else if (qspi_scr_covers(address))
+        edge = s_scr_base + s_scr_size;
+    else
+        return len;
+
+    size_t span = (size_t)(edge - address);
+    return (span < len) ? span : len;
+}
+
+/* An SPI-mode streaming transfer (qspi_spi_dma.c) owns the QSPI until its
+ * completion puts CTRLB back into memory mode: no instruction frames before */
+static inline bool qspi_memory_mode(void)
+{
+    return !QSPI_HW_IsSpiMode();
+}
+
 /* Harmony-style transfer prologue:
+ *  - refuse while an SPI-mode transfer runs
  *  - define INSTRADDR even for register commands
  *  - clear stale INSTREND so next transfer isn't ignored
  */
-static inline void qspi_begin_transfer_common(void)
+static inline bool qspi_begin_transfer_common(void)
 {
+    if (!qspi_memory_mode())
+        return false;
+
+    (void)qspi_cr_exit_if_active();
+    qspi_scr_off();
+
     if ((QSPI_REGS->QSPI_CTRLA & QSPI_CTRLA_ENABLE_Msk) == 0U)
     {
         QSPI_REGS->QSPI_CTRLA |= QSPI_CTRLA_ENABLE_Msk;
@@ -42,6 +139,14 @@ static inline void qspi_begin_transfer_common(void)
 
     /* Clear any stale completion so the next transfer can complete cleanly. */
     QSPI_REGS->QSPI_INTFLAG = QSPI_INTFLAG_INSTREND_Msk;
+    return true;
+}
+
+/* Memory-mode frames address the flash through the AHB window */
+static inline bool qspi_in_window(uint32_t address, size_t len)
+{
+    return (address < QSPI_HW_AHB_WINDOW_SIZE) &&
+           (len <= (size_t)(QSPI_HW_AHB_WINDOW_SIZE - address));
 }
 
 static inline void QSPI_HW_SyncInstr(void)
@@ -56,8 +161,14 @@ static inline bool qspi_end_transfer_wait(void)
     QSPI_REGS->QSPI_CTRLA = QSPI_CTRLA_ENABLE_Msk | QSPI_CTRLA_LASTXFER_Msk;
 
     uint32_t guard = 2000000UL;
+    QSPI_STAT_CYC_START();
     while (((QSPI_REGS->QSPI_INTFLAG & QSPI_INTFLAG_INSTREND_Msk) == 0U) && (guard-- != 0U)) { }
-    if (guard == 0U) return false;
+    QSPI_STAT_CYC_END();
+    if (guard == 0U)
+    {
+        QSPI_STAT_ADD(instrend_timeouts, 1U);
+        return false;
+    }
 
     /* Clear AFTER observe */
     QSPI_REGS->QSPI_INTFLAG = QSPI_INTFLAG_INSTREND_Msk;
@@ -185,9 +296,47 @@ void QSPI_HW_SetBaud(uint8_t baud_div)
     QSPI_REGS->QSPI_BAUD = QSPI_BAUD_BAUD((uint32_t)baud_div);
 }
 
+void QSPI_HW_SetSpiMode(bool spi)
+{
+    /* Memory mode must not be left with the flash latched in continuous read */
+    if (spi)
+    {
+        (void)qspi_cr_exit_if_active();
+    }
+
+    /* CTRLB is only rewritten with the module disabled (same as init) */
+    QSPI_HW_Disable();
+
+    if (spi)
+    {
+        /* MODE = SPI, CS held until LASTXFER, 8-bit characters */
+        QSPI_REGS->QSPI_CTRLB =
+            QSPI_CTRLB_MODE_SPI |
+            QSPI_CTRLB_CSMODE(QSPI_CTRLB_CSMODE_LASTXFER_Val) |
+            QSPI_CTRLB_DATALEN(QSPI_CTRLB_DATALEN_8BITS_Val);
+    }
+    else
+    {
+        /* Same as QSPI_HW_Init(): MODE = MEMORY, CSMODE = NORELOAD, DATALEN = 0x6 */
+        QSPI_REGS->QSPI_CTRLB =
+            QSPI_CTRLB_MODE_MEMORY |
+            QSPI_CTRLB_CSMODE(QSPI_CTRLB_CSMODE_NORELOAD_Val) |
+            QSPI_CTRLB_DATALEN(0x6U);
+    }
+
+    QSPI_HW_Enable();
+}
+
+bool QSPI_HW_IsSpiMode(void)
+{
+    return (QSPI_REGS->QSPI_CTRLB & QSPI_CTRLB_MODE_Msk) == QSPI_CTRLB_MODE_SPI;
+}
+
 bool QSPI_HW_Command(uint8_t opcode, qspi_width_t width)
 {
-    qspi_begin_transfer_common();
+    if (!qspi_begin_transfer_common())
+        return false;
+    QSPI_STAT_INSTR(QSPI_INSTR_CMD);
 
     QSPI_REGS->QSPI_INSTRCTRL = QSPI_INSTRCTRL_INSTR(opcode);
 
@@ -209,7 +358,10 @@ bool QSPI_HW_Read(uint8_t opcode, qspi_width_t width, void *rx, size_t rx_len)
         return false;
     }
 
-    qspi_begin_transfer_common();
+    if (!qspi_begin_transfer_common())
+        return false;
+    QSPI_STAT_INSTR(QSPI_INSTR_REG_READ);
+    QSPI_STAT_ADD(bytes_read, rx_len);
 
     QSPI_REGS->QSPI_INSTRCTRL = QSPI_INSTRCTRL_INSTR(opcode);
 
@@ -240,7 +392,10 @@ bool QSPI_HW_Write(uint8_t opcode, qspi_width_t width, const void *tx, size_t tx
         return false;
     }
 
-    qspi_begin_transfer_common();
+    if (!qspi_begin_transfer_common())
+        return false;
+    QSPI_STAT_INSTR(QSPI_INSTR_REG_WRITE);
+    QSPI_STAT_ADD(bytes_written, tx_len);
 
     QSPI_REGS->QSPI_INSTRCTRL = QSPI_INSTRCTRL_INSTR(opcode);
 
@@ -269,7 +424,9 @@ bool QSPI_HW_CommandAddr(uint8_t opcode,
                          qspi_addrlen_t addrlen,
                          uint32_t address)
 {
-    qspi_begin_transfer_common(); // important: enable + clear stale INSTREND
+    if (!qspi_begin_transfer_common())
+        return false;
+    QSPI_STAT_INSTR(QSPI_INSTR_CMD_ADDR);
 
     QSPI_REGS->QSPI_INSTRADDR = QSPI_INSTRADDR_ADDR(address);
     QSPI_REGS->QSPI_INSTRCTRL = QSPI_INSTRCTRL_INSTR(opcode);
@@ -297,7 +454,10 @@ bool QSPI_HW_ReadEx(uint8_t opcode,
         return false;
     }
 
-    qspi_begin_transfer_common();
+    if (!qspi_begin_transfer_common())
+        return false;
+    QSPI_STAT_INSTR(QSPI_INSTR_REG_READ);
+    QSPI_STAT_ADD(bytes_read, rx_len);
 
     QSPI_REGS->QSPI_INSTRCTRL = QSPI_INSTRCTRL_INSTR(opcode);
 
@@ -322,6 +482,129 @@ bool QSPI_HW_ReadEx(uint8_t opcode,
     return qspi_end_transfer_wait();
 }
 
+static bool qspi_reg_read_addr(uint8_t opcode,
+                               qspi_width_t width,
+                               qspi_addrlen_t addrlen,
+                               uint32_t address,
+                               bool opt_en,
+                               uint8_t optcode,
+                               uint8_t optlen_bits,
+                               uint8_t dummy_cycles,
+                               void *rx,
+                               size_t rx_len)
+{
+    if ((rx == NULL) || (rx_len == 0U))
+    {
+        return false;
+    }
+
+    if (!qspi_begin_transfer_common())
+        return false;
+    QSPI_STAT_INSTR(QSPI_INSTR_REG_READ);
+    QSPI_STAT_ADD(bytes_read, rx_len);
+
+    QSPI_REGS->QSPI_INSTRADDR = QSPI_INSTRADDR_ADDR(address);
+    QSPI_REGS->QSPI_INSTRCTRL = QSPI_INSTRCTRL_INSTR(opcode) |
+                                QSPI_INSTRCTRL_OPTCODE(optcode);
+
+    uint32_t frame =
+        QSPI_INSTRFRAME_WIDTH((uint32_t)width) |
+        QSPI_INSTRFRAME_TFRTYPE(QSPI_INSTRFRAME_TFRTYPE_READ_Val) |
+        QSPI_INSTRFRAME_INSTREN_Msk |
+        QSPI_INSTRFRAME_ADDREN_Msk |
+        QSPI_INSTRFRAME_ADDRLEN((uint32_t)addrlen) |
+        QSPI_INSTRFRAME_DATAEN_Msk |
+        QSPI_INSTRFRAME_DUMMYLEN((uint32_t)dummy_cycles);
+
+    if (opt_en)
+    {
+        frame |= QSPI_INSTRFRAME_OPTCODEEN_Msk;
+        frame |= QSPI_INSTRFRAME_OPTCODELEN((uint32_t)optlen_bits);
+    }
+
+    QSPI_REGS->QSPI_INSTRFRAME = frame;
+    QSPI_HW_SyncInstr();
+
+    uint8_t *dst = (uint8_t *)rx;
+    for (size_t i = 0; i < rx_len; i++)
+    {
+        dst[i] = (uint8_t)QSPI_MEM8[i];
+    }
+
+    __DSB();
+    __ISB();
+
+    return qspi_end_transfer_wait();
+}
+
+bool QSPI_HW_ReadAddr(uint8_t opcode,
+                      qspi_width_t width,
+                      qspi_addrlen_t addrlen,
+                      uint32_t address,
+                      uint8_t dummy_cycles,
+                      void *rx,
+                      size_t rx_len)
+{
+    return qspi_reg_read_addr(opcode, width, addrlen, address,
+                              false, 0U, 0U, dummy_cycles, rx, rx_len);
+}
+
+bool QSPI_HW_ReadAddrEx(uint8_t opcode,
+                        qspi_width_t width,
+                        qspi_addrlen_t addrlen,
+                        uint32_t address,
+                        uint8_t optcode,
+                        uint8_t optlen_bits,
+                        uint8_t dummy_cycles,
+                        void *rx,
+                        size_t rx_len)
+{
+    return qspi_reg_read_addr(opcode, width, addrlen, address,
+                              true, optcode, optlen_bits, dummy_cycles, rx, rx_len);
+}
+
+bool QSPI_HW_WriteAddr(uint8_t opcode,
+                       qspi_width_t width,
+                       qspi_addrlen_t addrlen,
+                       uint32_t address,
+                       const void *tx,
+                       size_t tx_len)
+{
+    if ((tx == NULL) || (tx_len == 0U))
+    {
+        return false;
+    }
+
+    if (!qspi_begin_transfer_common())
+        return false;
+    QSPI_STAT_INSTR(QSPI_INSTR_REG_WRITE);
+    QSPI_STAT_ADD(bytes_written, tx_len);
+
+    QSPI_REGS->QSPI_INSTRADDR = QSPI_INSTRADDR_ADDR(address);
+    QSPI_REGS->QSPI_INSTRCTRL = QSPI_INSTRCTRL_INSTR(opcode);
+
+    QSPI_REGS->QSPI_INSTRFRAME =
+        QSPI_INSTRFRAME_WIDTH((uint32_t)width) |
+        QSPI_INSTRFRAME_TFRTYPE(QSPI_INSTRFRAME_TFRTYPE_WRITE_Val) |
+        QSPI_INSTRFRAME_INSTREN_Msk |
+        QSPI_INSTRFRAME_ADDREN_Msk |
+        QSPI_INSTRFRAME_ADDRLEN((uint32_t)addrlen) |
+        QSPI_INSTRFRAME_DATAEN_Msk;
+
+    QSPI_HW_SyncInstr();
+
+    const uint8_t *src = (const uint8_t *)tx;
+    for (size_t i = 0; i < tx_len; i++)
+    {
+        QSPI_MEM8[i] = src[i];
+    }
+
+    __DSB();
+    __ISB();
+
+    return qspi_end_transfer_wait();
+}
+
 bool QSPI_HW_MemoryRead_Simple(
     uint8_t opcode,
     qspi_width_t width,
@@ -346,25 +629,26 @@ bool QSPI_HW_MemoryRead_Simple(
 }
 
 
-bool QSPI_HW_MemoryRead(uint8_t opcode,
-                        qspi_width_t width,
-                        qspi_addrlen_t addrlen,
-                        bool opt_en,
-                        uint8_t optcode,
-                        uint8_t optlen_bits,
-                        uint8_t dummy_cycles,
-                        void *rx,
-                        size_t rx_len,
-                        uint32_t address)
+static bool qspi_memory_read_frame(uint8_t opcode,
+                                   qspi_width_t width,
+                                   qspi_addrlen_t addrlen,
+                                   bool opt_en,
+                                   uint8_t optcode,
+                                   uint8_t optlen_bits,
+                                   uint8_t dummy_cycles,
+                                   bool crmode,
+                                   void *rx,
+                                   size_t rx_len,
+                                   uint32_t address)
 {
-    if ((rx == NULL) || (rx_len == 0U))
-    {
+    if (!qspi_memory_mode())
         return false;
-    }
 
     /* Clear stale completion before starting a new instruction */
     QSPI_REGS->QSPI_INTFLAG = QSPI_INTFLAG_INSTREND_Msk;
 
+    qspi_scr_apply(address);
+
     /* Program address/opcode */
     QSPI_REGS->QSPI_INSTRADDR = QSPI_INSTRADDR_ADDR(address);
     QSPI_REGS->QSPI_INSTRCTRL = QSPI_INSTRCTRL_INSTR(opcode) |
@@ -390,6 +674,12 @@ bool QSPI_HW_MemoryRead(uint8_t opcode,
         frame |= QSPI_INSTRFRAME_DUMMYLEN((uint32_t)dummy_cycles);
     }
 
+    /* CRMODE: QSPI drops the opcode once the flash has latched it */
+    if (crmode)
+    {
+        frame |= QSPI_INSTRFRAME_CRMODE_Msk;
+    }
+
     QSPI_REGS->QSPI_INSTRFRAME = frame;
     QSPI_HW_SyncInstr();
 
@@ -397,9 +687,16 @@ bool QSPI_HW_MemoryRead(uint8_t opcode,
     uint8_t *dst8 = (uint8_t *)rx;
     const volatile uint8_t *src8 = (const volatile uint8_t *)(QSPI_ADDR | address);
 
-    for (size_t i = 0; i < rx_len; i++)
+    if (s_read_copy != NULL)
     {
-        dst8[i] = src8[i];
+        s_read_copy(dst8, src8, rx_len);
+    }
+    else
+    {
+        for (size_t i = 0; i < rx_len; i++)
+        {
+            dst8[i] = src8[i];
+        }
     }
 
     __DSB();
@@ -408,6 +705,206 @@ bool QSPI_HW_MemoryRead(uint8_t opcode,
     return qspi_end_transfer_wait();
 }
 
+/*
+ * Leave continuous read: repeat the read frame (still without opcode) carrying
+ * the exit option code, then drop CRMODE so the next frame sends its opcode.
+ */
+static bool qspi_cr_exit_if_active(void)
+{
+    if (!s_cr_active)
+        return true;
+
+    s_cr_active = false;
+
+    QSPI_STAT_INSTR(QSPI_INSTR_CR_EXIT);
+
+    uint8_t discard = 0U;
+    return qspi_memory_read_frame(s_cr_cfg.opcode,
+                                  s_cr_cfg.width,
+                                  s_cr_cfg.addrlen,
+                                  true,
+                                  s_cr_cfg.mode_exit,
+                                  s_cr_cfg.optlen,
+                                  s_cr_cfg.dummy_cycles,
+                                  true,
+                                  &discard,
+                                  1U,
+                                  s_cr_last_addr);
+}
+
+bool QSPI_HW_MemoryRead(uint8_t opcode,
+                        qspi_width_t width,
+                        qspi_addrlen_t addrlen,
+                        bool opt_en,
+                        uint8_t optcode,
+                        uint8_t optlen_bits,
+                        uint8_t dummy_cycles,
+                        void *rx,
+                        size_t rx_len,
+                        uint32_t address)
+{
+    if ((rx == NULL) || (rx_len == 0U) || !qspi_in_window(address, rx_len))
+    {
+        return false;
+    }
+
+    if (!qspi_cr_exit_if_active())
+    {
+        return false;
+    }
+
+    uint8_t *dst = (uint8_t *)rx;
+    while (rx_len != 0U)
+    {
+        size_t n = qspi_scr_span(address, rx_len);
+        QSPI_STAT_INSTR(QSPI_INSTR_MEM_READ);
+        QSPI_STAT_ADD(bytes_read, n);
+        if (!qspi_memory_read_frame(opcode, width, addrlen,
+                                    opt_en, optcode, optlen_bits,
+                                    dummy_cycles, false,
+                                    dst, n, address))
+        {
+            return false;
+        }
+        dst += n;
+        address += (uint32_t)n;
+        rx_len -= n;
+    }
+    return true;
+}
+
+bool QSPI_HW_MemoryRead_Continuous(const qspi_cont_read_cfg_t *cfg,
+                                   void *rx,
+                                   size_t rx_len,
+                                   uint32_t address)
+{
+    if ((cfg == NULL) || (rx == NULL) || (rx_len == 0U) || !qspi_in_window(address, rx_len))
+    {
+        return false;
+    }
+
+    /* A different read command cannot reuse the latched opcode */
+    if (s_cr_active && (s_cr_cfg.opcode != cfg->opcode))
+    {
+        if (!qspi_cr_exit_if_active())
+            return false;
+    }
+
+    /* First frame carries the opcode; the mode byte then keeps the flash latched */
+    uint8_t *dst = (uint8_t *)rx;
+    bool ok = true;
+    while (ok && (rx_len != 0U))
+    {
+        size_t n = qspi_scr_span(address, rx_len);
+        QSPI_STAT_INSTR(QSPI_INSTR_MEM_READ);
+        QSPI_STAT_ADD(bytes_read, n);
+        ok = qspi_memory_read_frame(cfg->opcode,
+                                    cfg->width,
+                                    cfg->addrlen,
+                                    true,
+                                    cfg->mode_enter,
+                                    cfg->optlen,
+                                    cfg->dummy_cycles,
+                                    true,
+                                    dst, n, address);
+        if (!ok)
+            break;
+        s_cr_last_addr = address;
+        dst += n;
+        address += (uint32_t)n;
+        rx_len -= n;
+    }
+
+    /* A failed frame ends the chain: the next read starts with the opcode */
+    s_cr_cfg    = *cfg;
+    s_cr_active = ok;
+    if (!ok)
+        s_cr_last_addr = 0U;
+    return ok;
+}
+
+void QSPI_HW_SetReadCopy(qspi_read_copy_t fn)
+{
+    s_read_copy = fn;
+}
+
+qspi_read_copy_t QSPI_HW_GetReadCopy(void)
+{
+    return s_read_copy;
+}
+
+bool QSPI_HW_ContinuousRead_Exit(void)
+{
+    return qspi_cr_exit_if_active();
+}
+
+bool QSPI_HW_ContinuousRead_IsActive(void)
+{
+    return s_cr_active;
+}
+
+bool QSPI_HW_Scramble_Config(uint32_t key, uint32_t base, uint32_t size, bool chip_unique)
+{
+    if ((size == 0U) ||
+        (base >= QSPI_HW_AHB_WINDOW_SIZE) ||
+        (size > (QSPI_HW_AHB_WINDOW_SIZE - base)) ||
+        ((base % QSPI_SCRAMBLE_ALIGN) != 0U) ||
+        ((size % QSPI_SCRAMBLE_ALIGN) != 0U))
+    {
+        return false;
+    }
+
+    if (!qspi_cr_exit_if_active())
+    {
+        return false;
+    }
+
+    /* Key is loaded with the module disabled, like CTRLB */
+    QSPI_HW_Disable();
+    QSPI_REGS->QSPI_SCRAMBCTRL = 0U;
+    QSPI_REGS->QSPI_SCRAMBKEY  = QSPI_SCRAMBKEY_KEY(key);
+    QSPI_HW_Enable();
+
+    s_scr_base     = base;
+    s_scr_size     = size;
+    s_scr_ctrl     = QSPI_SCRAMBCTRL_ENABLE_Msk |
+                     (chip_unique ? 0U : QSPI_SCRAMBCTRL_RANDOMDIS_Msk);
+    s_scr_ctrl_cur = 0U;
+    s_scr_enabled  = true;
+    return true;
+}
+
+void QSPI_HW_Scramble_Disable(void)
+{
+    (void)qspi_cr_exit_if_active();
+
+    s_scr_enabled = false;
+    s_scr_ctrl_cur = 1U;    /* force the write */
+    qspi_scr_off();
+}
+
+bool QSPI_HW_Scramble_IsEnabled(void)
+{
+    return s_scr_enabled;
+}
+
+bool QSPI_HW_Scramble_Covers(uint32_t address)
+{
+    return qspi_scr_covers(address);
+}
+
+bool QSPI_HW_Scramble_Overlaps(uint32_t address, uint32_t len)
+{
+    return s_scr_enabled && (len != 0U) &&
+           (address < (s_scr_base + s_scr_size)) && (s_scr_base < (address + len));
+}
+
+void QSPI_HW_Scramble_Select(uint32_t address)
+{
+    (void)qspi_cr_exit_if_active();
+    qspi_scr_apply(address);
+}
+
 bool QSPI_HW_MemoryWrite(uint8_t opcode,
                          qspi_width_t width,
                          qspi_addrlen_t addrlen,
@@ -419,7 +916,19 @@ bool QSPI_HW_MemoryWrite(uint8_t opcode,
                          size_t tx_len,
                          uint32_t address)
 {
-    if ((tx == NULL) || (tx_len == 0U))
+    if ((tx == NULL) || (tx_len == 0U) || !qspi_in_window(address, tx_len) ||
+        !qspi_memory_mode())
+    {
+        return false;
+    }
+
+    if (!qspi_cr_exit_if_active())
+    {
+        return false;
+    }
+
+    /* One program command cannot change scrambling half way */
+    if (qspi_scr_span(address, tx_len) != tx_len)
     {
         return false;
     }
@@ -427,6 +936,11 @@ bool QSPI_HW_MemoryWrite(uint8_t opcode,
     /* Clear stale completion before starting a new instruction */
     QSPI_REGS->QSPI_INTFLAG = QSPI_INTFLAG_INSTREND_Msk;
 
+    qspi_scr_apply(address);
+
+    QSPI_STAT_INSTR(QSPI_INSTR_MEM_WRITE);
+    QSPI_STAT_ADD(bytes_written, tx_len);
+
     QSPI_REGS->QSPI_INSTRADDR = QSPI_INSTRADDR_ADDR(address);
     QSPI_REGS->QSPI_INSTRCTRL = QSPI_INSTRCTRL_INSTR(opcode) |
                                 (opt_en ? QSPI_INSTRCTRL_OPTCODE(optcode) : 0U);
@@ -478,3 +992,118 @@ bool QSPI_HW_MemoryWrite(uint8_t opcode,
 
     return qspi_end_transfer_wait();
 }
+
+void QSPI_HW_Stats_Get(qspi_hw_stats_t *out)
+{
+    if (out == NULL)
+        return;
+#if QSPI_HW_STATS
+    *out = s_stats;
+#else
+    memset(out, 0, sizeof(*out));
+#endif
+}
+
+void QSPI_HW_Stats_Reset(void)
+{
+#if QSPI_HW_STATS
+    memset(&s_stats, 0, sizeof(s_stats));
+#endif
+}
+
+const char *QSPI_HW_Stats_InstrName(qspi_instr_type_t type)
+{
+    static const char * const names[QSPI_INSTR_TYPE_COUNT] =
+    {
+        "CMD", "CMD+ADDR", "REG READ", "REG WRITE", "MEM READ", "MEM WRITE", "CR EXIT"
+    };
+    return ((uint32_t)type < (uint32_t)QSPI_INSTR_TYPE_COUNT) ? names[type] : "?";
+}
+
+const char *QSPI_HW_Stats_BusyOpName(qspi_busy_op_t op)
+{
+    static const char * const names[QSPI_BUSY_OP_COUNT] =
+    {
+        "PAGE PROG", "SECT ERASE", "BLK ERASE", "CHIP ERASE", "REG WRITE", "SUSPEND"
+    };
+    return ((uint32_t)op < (uint32_t)QSPI_BUSY_OP_COUNT) ? names[op] : "?";
+}
+
+void QSPI_HW_Stats_AddOp(qspi_busy_op_t op, uint32_t us, bool ok)
+{
+#if QSPI_HW_STATS
+    if ((uint32_t)op >= (uint32_t)QSPI_BUSY_OP_COUNT)
+        return;
+
+    qspi_busy_op_stats_t *o = &s_stats.busy_op[op];
+    if (!ok)
+    {
+        o->timeouts++;
+        return;
+    }
+    if ((o->count == 0U) || (us < o->min_us))
+        o->min_us = us;
+    if (us > o->max_us)
+        o->max_us = us;
+    o->last_us   = us;
+    o->total_us += us;
+    o->count++;
+#else
+    (void)op;
+    (void)us;
+    (void)ok;
+#endif
+}
+
+bool QSPI_HW_WaitReady(qspi_read_sr_fn_t read_sr, uint8_t busy_mask,
+                       qspi_busy_op_t op, const qspi_busy_timing_t *t)
+{
+    if ((read_sr == NULL) || (t == NULL))
+        return false;
+
+    const uint32_t cyc_per_us = (uint32_t)(CPU_CLOCK_HZ / 1000000UL);
+    const uint64_t limit = (uint64_t)t->max_us * cyc_per_us;
+    uint64_t elapsed  = 0U;
+    uint64_t next     = (uint64_t)t->typ_us * cyc_per_us;
+    uint32_t interval = QSPI_HW_POLL_MIN_US;
+    uint32_t last     = DWT->CYCCNT;
+    uint32_t polls    = 0U;
+    bool ok = false;
+
+    for (;;)
+    {
+        uint32_t now = DWT->CYCCNT;
+        elapsed += (uint32_t)(now - last);
+        last = now;
+
+        if ((elapsed < next) && (elapsed < limit))
+            continue;
+
+        uint8_t sr = 0U;
+        if (!read_sr(&sr))
+            break;
+        polls++;
+
+        if ((sr & busy_mask) == 0U)
+        {
+            ok = true;
+            break;
+        }
+        if (elapsed >= limit)
+            break;
+
+        next = elapsed + ((uint64_t)interval * cyc_per_us);
+        interval = (interval >= (QSPI_HW_POLL_MAX_US / 2U)) ? QSPI_HW_POLL_MAX_US
+                                                           : (interval * 2U);
+    }
+
+#if QSPI_HW_STATS
+    s_stats.busy_cycles += elapsed;
+    s_stats.busy_waits++;
+    s_stats.busy_polls  += polls;
+#else
+    (void)polls;
+#endif
+    QSPI_HW_Stats_AddOp(op, (uint32_t)(elapsed / cyc_per_us), ok);
+    return ok;
+}
@@ -37,6 +37,104 @@ typedef enum
     QSPI_ADDRLEN_32BITS = 3,
 } qspi_addrlen_t;
 
+/*
+ * Memory-mode frames (QSPI_HW_MemoryRead*, QSPI_HW_MemoryWrite) send the
+ * address of the AHB access, so they reach the first 16 MB of the flash
+ * only. Above that, use the register-style frames that take the address
+ * from INSTRADDR (QSPI_HW_ReadAddr*, QSPI_HW_WriteAddr). Scrambling only
+ * applies to memory-mode frames.
+ */
+#define QSPI_HW_AHB_WINDOW_SIZE     (0x01000000UL)
+
+/*
+ * Continuous-read (mode byte / XIP) profile.
+ * The option code is sent right after the address; a flash that accepts
+ * mode_enter keeps the read opcode latched, so following frames are sent
+ * without it (INSTRFRAME.CRMODE). mode_exit releases the flash again.
+ */
+typedef struct
+{
+    uint8_t        opcode;
+    qspi_width_t   width;
+    qspi_addrlen_t addrlen;
+    uint8_t        mode_enter;     /* option code that keeps the opcode latched */
+    uint8_t        mode_exit;      /* option code that leaves continuous read   */
+    uint8_t        optlen;         /* QSPI_INSTRFRAME_OPTCODELEN_xxx_Val        */
+    uint8_t        dummy_cycles;   /* dummy cycles after the option code        */
+} qspi_cont_read_cfg_t;
+
+/* 1 = count instructions/bytes and DWT cycles spent waiting on the bus */
+#ifndef QSPI_HW_STATS
+#define QSPI_HW_STATS   1
+#endif
+
+typedef enum
+{
+    QSPI_INSTR_CMD = 0,     /* opcode only (WREN, reset, ...)          */
+    QSPI_INSTR_CMD_ADDR,    /* opcode + address (erase)                */
+    QSPI_INSTR_REG_READ,    /* register read (status, JEDEC, SFDP...)  */
+    QSPI_INSTR_REG_WRITE,   /* register write                          */
+    QSPI_INSTR_MEM_READ,    /* memory read frame (incl. continuous)    */
+    QSPI_INSTR_MEM_WRITE,   /* page program frame                      */
+    QSPI_INSTR_CR_EXIT,     /* continuous-read exit frame              */
+    QSPI_INSTR_TYPE_COUNT
+} qspi_instr_type_t;
+
+/* Flash operations timed by QSPI_HW_WaitReady() */
+typedef enum
+{
+    QSPI_BUSY_PAGE_PROG = 0,
+    QSPI_BUSY_SECTOR_ERASE,     /* 4K */
+    QSPI_BUSY_BLOCK_ERASE,      /* 8K..64K */
+    QSPI_BUSY_CHIP_ERASE,
+    QSPI_BUSY_REG_WRITE,        /* status/config register writes */
+    QSPI_BUSY_SUSPEND,          /* erase/program suspend latency */
+    QSPI_BUSY_OP_COUNT
+} qspi_busy_op_t;
+
+/* Datasheet timing of one operation */
+typedef struct
+{
+    uint32_t typ_us;    /* first status poll after this (typical time) */
+    uint32_t max_us;    /* timeout (datasheet max + margin) */
+} qspi_busy_timing_t;
+
+/*
+ * Status polls after the first one back off from QSPI_HW_POLL_MIN_US,
+ * doubling up to QSPI_HW_POLL_MAX_US, so a late operation costs a few
+ * status reads instead of thousands of back-to-back ones.
+ */
+#ifndef QSPI_HW_POLL_MIN_US
+#define QSPI_HW_POLL_MIN_US     (2U)
+#endif
+#ifndef QSPI_HW_POLL_MAX_US
+#define QSPI_HW_POLL_MAX_US     (1000U)
+#endif
+
+/* Measured duration of each kind of operation (telemetry) */
+typedef struct
+{
+    uint32_t count;
+    uint32_t timeouts;
+    uint32_t last_us;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t total_us;
+} qspi_busy_op_stats_t;
+
+typedef struct
+{
+    uint32_t instr[QSPI_INSTR_TYPE_COUNT];
+    uint64_t bytes_read;            /* data phase bytes, register + memory */
+    uint64_t bytes_written;
+    uint64_t instrend_cycles;       /* CPU spinning on INTFLAG.INSTREND */
+    uint32_t instrend_timeouts;
+    uint64_t busy_cycles;           /* CPU polling flash WIP (includes its status reads) */
+    uint32_t busy_waits;
+    uint32_t busy_polls;            /* status reads issued by the waits */
+    qspi_busy_op_stats_t busy_op[QSPI_BUSY_OP_COUNT];
+} qspi_hw_stats_t;
+
 void QSPI_HW_Initialize(void);
 void QSPI_HW_PinInit(void);
 /* Initialize QSPI peripheral (clock masks + SWRST + basic MODE_MEMORY setup). */
@@ -44,6 +142,15 @@ void QSPI_HW_Init(void);
 /* Enable/disable the QSPI peripheral. */
 void QSPI_HW_Enable(void);
 void QSPI_HW_Disable(void);
+void QSPI_HW_SetBaud(uint8_t baud_div);
+
+/*
+ * Switch CTRLB between serial-memory mode (instruction frames + AHB window)
+ * and plain SPI mode (TXDATA/RXDATA, CS held until LASTXFER). While in SPI
+ * mode every QSPI_HW_* flash access returns false.
+ */
+void QSPI_HW_SetSpiMode(bool spi);
+bool QSPI_HW_IsSpiMode(void);
 
 
 
@@ -66,6 +173,34 @@ bool QSPI_HW_CommandAddr(uint8_t opcode,
                          qspi_addrlen_t addrlen,
                          uint32_t address);
 
+/* Register-style read with an address phase (SFDP 5Ah, security/ID pages) */
+bool QSPI_HW_ReadAddr(uint8_t opcode,
+                      qspi_width_t width,
+                      qspi_addrlen_t addrlen,
+                      uint32_t address,
+                      uint8_t dummy_cycles,
+                      void *rx,
+                      size_t rx_len);
+
+/* Same with an option code (mode byte) after the address */
+bool QSPI_HW_ReadAddrEx(uint8_t opcode,
+                        qspi_width_t width,
+                        qspi_addrlen_t addrlen,
+                        uint32_t address,
+                        uint8_t optcode,
+                        uint8_t optlen_bits,
+                        uint8_t dummy_cycles,
+                        void *rx,
+                        size_t rx_len);
+
+/* Register-style write with an address phase (program above the AHB window) */
+bool QSPI_HW_WriteAddr(uint8_t opcode,
+                       qspi_width_t width,
+                       qspi_addrlen_t addrlen,
+                       uint32_t address,
+                       const void *tx,
+                       size_t tx_len);
+
 bool QSPI_HW_ReadEx(uint8_t opcode,
                     qspi_width_t width,
                     uint8_t dummy_cycles,
@@ -94,6 +229,49 @@ bool QSPI_HW_MemoryRead(
     uint32_t address
 );
 
+/*
+ * Copy routine used to drain the AHB window during memory reads.
+ * NULL restores the default byte loop. Used by the benchmark to compare
+ * CPU byte/word copies against a DMAC copy.
+ */
+typedef void (*qspi_read_copy_t)(void *dst, const volatile void *src, size_t len);
+void QSPI_HW_SetReadCopy(qspi_read_copy_t fn);
+qspi_read_copy_t QSPI_HW_GetReadCopy(void);
+
+/*
+ * Memory read in continuous-read mode (see qspi_cont_read_cfg_t).
+ * Any other QSPI_HW_* instruction automatically exits continuous read first.
+ */
+bool QSPI_HW_MemoryRead_Continuous(const qspi_cont_read_cfg_t *cfg,
+                                   void *rx,
+                                   size_t rx_len,
+                                   uint32_t address);
+bool QSPI_HW_ContinuousRead_Exit(void);
+bool QSPI_HW_ContinuousRead_IsActive(void);
+
+/*
+ * Hardware scrambling for one flash partition [base, base + size).
+ *
+ * Memory reads/writes (QSPI_HW_MemoryRead*, QSPI_HW_MemoryWrite) switch
+ * SCRAMBCTRL per frame, so data inside the partition is stored scrambled and
+ * read back in clear with no CPU work; everything else stays raw. Reads that
+ * straddle the partition edge are split. base/size must be 4 KB aligned so a
+ * page program never straddles it.
+ *
+ * Scrambling depends on the address, so erased (0xFF) flash inside the
+ * partition does not read back as 0xFF. chip_unique adds the per-device
+ * random value: data then only decodes on this MCU.
+ *
+ * Raw AHB pointer reads (XIP) use the SCRAMBCTRL state of the last frame;
+ * call QSPI_HW_Scramble_Select() with the address before such accesses.
+ */
+bool QSPI_HW_Scramble_Config(uint32_t key, uint32_t base, uint32_t size, bool chip_unique);
+void QSPI_HW_Scramble_Disable(void);
+bool QSPI_HW_Scramble_IsEnabled(void);
+bool QSPI_HW_Scramble_Covers(uint32_t address);
+bool QSPI_HW_Scramble_Overlaps(uint32_t address, uint32_t len);
+void QSPI_HW_Scramble_Select(uint32_t address);
+
 bool QSPI_HW_MemoryWrite(uint8_t opcode,
                          qspi_width_t width,
                          qspi_addrlen_t addrlen,
@@ -105,4 +283,29 @@ bool QSPI_HW_MemoryWrite(uint8_t opcode,
                          size_t tx_len,
                          uint32_t address);
 
+/*
+ * Bus statistics (all zero when QSPI_HW_STATS == 0).
+ * Cycle counters use DWT->CYCCNT, enabled at boot by SystemConfigPerformance().
+ */
+void QSPI_HW_Stats_Get(qspi_hw_stats_t *out);
+void QSPI_HW_Stats_Reset(void);
+const char *QSPI_HW_Stats_InstrName(qspi_instr_type_t type);
+const char *QSPI_HW_Stats_BusyOpName(qspi_busy_op_t op);
+/* Record the duration of one operation (non-blocking pollers, e.g. qspi_job) */
+void QSPI_HW_Stats_AddOp(qspi_busy_op_t op, uint32_t us, bool ok);
+
+/* Status read used by QSPI_HW_WaitReady(); busy bits are tested with a mask */
+typedef bool (*qspi_read_sr_fn_t)(uint8_t *sr_out);
+
+/*
+ * Datasheet-timed busy wait: no status read until t->typ_us has passed,
+ * then reads with exponential backoff (QSPI_HW_POLL_MIN_US..MAX_US) until
+ * (sr & busy_mask) == 0 or t->max_us runs out. Time comes from DWT->CYCCNT
+ * (accumulated per pass, so waits longer than a CYCCNT wrap are fine).
+ * The CPU spins without bus traffic between reads. The duration is
+ * recorded under op.
+ */
+bool QSPI_HW_WaitReady(qspi_read_sr_fn_t read_sr, uint8_t busy_mask,
+                       qspi_busy_op_t op, const qspi_busy_timing_t *t);
+
 #endif /* QSPI_HW_H */
@@ -0,0 +1,146 @@
+/* qspi_index.c: RAM index type_id -> object location */
+
+#include <stddef.h>
+#include "qspi_index.h"
+
+static inline uint32_t index_home(const qspi_index_t *idx, uint32_t type_id)
+{
+    uint32_t h = type_id * 2654435761UL;    /* Fibonacci hashing */
+    return (h ^ (h >> 16)) & idx->mask;
+}
+
+static inline bool index_empty(const qspi_index_entry_t *e)
+{
+    return e->address == QSPI_INDEX_EMPTY;
+}
+
+/* Slot holding type_id, or the empty slot that ends its probe sequence */
+static uint32_t index_probe(const qspi_index_t *idx, uint32_t type_id, uint32_t *probes)
+{
+    uint32_t i = index_home(idx, type_id);
+    uint32_t n = 1U;
+
+    while (!index_empty(&idx->slots[i]) && (idx->slots[i].type_id != type_id))
+    {
+        i = (i + 1U) & idx->mask;
+        n++;
+    }
+    if (probes != NULL)
+        *probes = n;
+    return i;
+}
+
+void QSPI_Index_Init(qspi_index_t *idx, qspi_index_entry_t *slots, uint32_t nslots)
+{
+    idx->slots = slots;
+    idx->mask  = nslots - 1U;
+    QSPI_Index_Clear(idx);
+}
+
+void QSPI_Index_Clear(qspi_index_t *idx)
+{
+    for (uint32_t i = 0; i <= idx->mask; i++)
+        idx->slots[i].address = QSPI_INDEX_EMPTY;
+    idx->count = 0U;
+    idx->dropped = 0U;
+    idx->probes_max = 0U;
+}
+
+void QSPI_Index_Load(qspi_index_t *idx, qspi_index_entry_t *slots, uint32_t nslots)
+{
+    idx->slots = slots;
+    idx->mask  = nslots - 1U;
+    idx->count = 0U;
+    idx->dropped = 0U;
+    idx->probes_max = 0U;
+    for (uint32_t i = 0; i < nslots; i++)
+    {
+        if (!index_empty(&slots[i]))
+            idx->count++;
+    }
+}
+
+const qspi_index_entry_t *QSPI_Index_Get(const qspi_index_t *idx, uint32_t type_id)
+{
+    const qspi_index_entry_t *e = &idx->slots[index_probe(idx, type_id, NULL)];
+    return index_empty(e) ? NULL : e;
+}
+
+bool QSPI_Index_HasRoom(const qspi_index_t *idx)
+{
+    uint32_t nslots = idx->mask + 1U;
+    return idx->count < (nslots - (nslots / 4U));
+}
+
+bool QSPI_Index_Put(qspi_index_t *idx, const qspi_index_entry_t *e)
+{
+    uint32_t probes;
+    uint32_t i = index_probe(idx, e->type_id, &probes);
+
+    if (index_empty(&idx->slots[i]))
+    {
+        if (!QSPI_Index_HasRoom(idx))
+        {
+            idx->dropped++;
+            return false;
+        }
+        idx->count++;
+    }
+
+    idx->slots[i] = *e;
+    if (probes > idx->probes_max)
+        idx->probes_max = probes;
+    return true;
+}
+
+/* Backward-shift deletion: pull later entries of the cluster into the hole
+ * unless their home slot lies cyclically in (hole, j] */
+static void index_remove_slot(qspi_index_t *idx, uint32_t i)
+{
+    uint32_t j = i;
+
+    for (;;)
+    {
+        j = (j + 1U) & idx->mask;
+        if (index_empty(&idx->slots[j]))
+            break;
+
+        uint32_t k = index_home(idx, idx->slots[j].type_id);
+        bool stays = (i <= j) ? ((i < k) && (k <= j)) : ((i < k) || (k <= j));
+        if (stays)
+            continue;
+
+        idx->slots[i] = idx->slots[j];
+        i = j;
+    }
+
+    idx->slots[i].address = QSPI_INDEX_EMPTY;
+    idx->count--;
+}
+
+bool QSPI_Index_Remove(qspi_index_t *idx, uint32_t type_id)
+{
+    uint32_t i = index_probe(idx, type_id, NULL);
+
+    if (index_empty(&idx->slots[i]))
+        return false;
+    index_remove_slot(idx, i);
+    return true;
+}
+
+void QSPI_Index_RemoveRange(qspi_index_t *idx, uint32_t addr, uint32_t len, uint32_t hdr_len)
+{
+    uint32_t i = 0U;
+
+    while (i <= idx->mask)
+    {
+        const qspi_index_entry_t *e = &idx->slots[i];
+        if (!index_empty(e) &&
+            (e->address < (addr + len)) && (addr < (e->address + hdr_len + e->len)))
+        {
+            index_remove_slot(idx, i);      /* slot i may now hold a shifted entry */
+            continue;
+        }
+        i++;
+    }
+}
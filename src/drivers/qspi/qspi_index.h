@@ -0,0 +1,62 @@
+/* qspi_index.h: RAM index type_id -> object location
+ *
+ * Both object stores keep one of these, built by scanning the headers at
+ * mount and updated on every write/erase, so a lookup by type is one hash
+ * probe instead of a flash scan or a fixed-sector convention.
+ *
+ * Open addressing with linear probing over a caller-provided power-of-two
+ * slot array; removal shifts the following entries back (no tombstones), so
+ * lookups never degrade with churn. New keys are refused above 3/4 load.
+ */
+
+#ifndef QSPI_INDEX_H
+#define QSPI_INDEX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define QSPI_INDEX_EMPTY        (0xFFFFFFFFUL)  /* address of a free slot */
+
+/* entry flags */
+#define QSPI_INDEX_F_DELETED    (0x0001U)       /* log: newest record is a delete marker */
+#define QSPI_INDEX_F_VERIFIED   (0x0002U)       /* sector store: header + payload CRC checked */
+
+typedef struct
+{
+    uint32_t type_id;
+    uint32_t address;           /* object header */
+    uint32_t len;               /* payload bytes */
+    uint32_t version;
+    uint32_t seq;               /* log sequence number (0 in the sector store) */
+    uint32_t flags;
+} qspi_index_entry_t;
+
+typedef struct
+{
+    qspi_index_entry_t *slots;
+    uint32_t mask;              /* slot count - 1 */
+    uint32_t count;
+    uint32_t dropped;           /* Put() refused, table full */
+    uint32_t probes_max;        /* longest probe sequence seen */
+} qspi_index_t;
+
+/* nslots must be a power of two */
+void QSPI_Index_Init(qspi_index_t *idx, qspi_index_entry_t *slots, uint32_t nslots);
+void QSPI_Index_Clear(qspi_index_t *idx);
+/* Adopt slots filled from a saved copy (checkpoint) and recount them */
+void QSPI_Index_Load(qspi_index_t *idx, qspi_index_entry_t *slots, uint32_t nslots);
+
+/* NULL if type_id is not indexed. The pointer is valid until the next Put/Remove. */
+const qspi_index_entry_t *QSPI_Index_Get(const qspi_index_t *idx, uint32_t type_id);
+
+/* Insert or replace the entry of e->type_id; false = table full */
+bool QSPI_Index_Put(qspi_index_t *idx, const qspi_index_entry_t *e);
+bool QSPI_Index_HasRoom(const qspi_index_t *idx);
+
+bool QSPI_Index_Remove(qspi_index_t *idx, uint32_t type_id);
+
+/* Drop every entry whose object [address, address + hdr_len + len)
+ * overlaps [addr, addr + len) (the range was erased) */
+void QSPI_Index_RemoveRange(qspi_index_t *idx, uint32_t addr, uint32_t len, uint32_t hdr_len);
+
+#endif /* QSPI_INDEX_H */
@@ -0,0 +1,611 @@
+/* qspi_job.c: Non-blocking flash job engine (erase / program / verify) */
+
+#include <stdio.h>
+#include <string.h>
+#include "../../common/systick.h"
+#include "../../common/board.h"
+#include "qspi_job.h"
+#include "qspi_flash.h"
+#include "qspi_hw.h"
+#include "qspi_wear.h"
+#include "qspi_log.h"
+#include "qspi_cache.h"
+
+/* WIP is status register bit0 on every supported part (see qspi_flash_ops.h) */
+#define QSPI_JOB_SR_WIP_Msk     (0x01U)
+
+typedef enum
+{
+    JOB_IDLE = 0,
+    JOB_ERASE_ISSUE,
+    JOB_BLANK_CHECK,
+    JOB_ERASE_WAIT,
+    JOB_PROG_ISSUE,
+    JOB_PROG_WAIT,
+    JOB_VERIFY,
+    JOB_CHIP_WAIT,
+} qspi_job_state_t;
+
+typedef struct
+{
+    qspi_job_state_t        state;
+    const qspi_flash_ops_t *ops;
+
+    uint32_t        erase_addr;
+    uint32_t        erase_end;
+    uint32_t        erase_unit;     /* size of the erase in flight */
+    uint32_t        blank_off;      /* blank check progress inside the unit */
+
+    qspi_job_seg_t  segs[QSPI_JOB_MAX_SEGS];
+    uint32_t        nseg;
+    uint32_t        seg;            /* current segment */
+    uint32_t        off;            /* offset inside it */
+    bool            verify;
+
+    /* Current wait (JOB_*_WAIT), timed on DWT; suspended time not counted */
+    qspi_busy_op_t  op;
+    uint64_t        busy_cyc;       /* time the operation has been running */
+    uint32_t        last_cyc;
+    uint64_t        next_poll;      /* no status read before busy_cyc reaches this */
+    uint64_t        limit;          /* timeout */
+    uint32_t        interval_us;    /* backoff */
+    bool            ready;          /* completion seen (and recorded) */
+
+    /* Range of the erase/program in flight (JOB_*_WAIT) */
+    uint32_t        busy_addr;
+    uint32_t        busy_len;
+
+    bool            suspended;
+    uint32_t        suspend_depth;  /* nested Suspend calls inside the outer one */
+
+    qspi_job_cb_t   cb;
+    void           *ctx;
+} qspi_job_t;
+
+static qspi_job_t s_job;
+static bool s_last_ok;
+static void (*s_idle_hook)(void);
+
+static qspi_job_stats_t s_stats;
+static uint32_t s_resume_cyc;
+static bool     s_resume_valid;
+
+static void job_finish(bool ok)
+{
+    qspi_job_cb_t cb = s_job.cb;
+    void *ctx = s_job.ctx;
+
+    s_job.state = JOB_IDLE;
+    s_last_ok = ok;
+
+    if (cb != NULL)
+        cb(ok, ctx);
+}
+
+#define JOB_CYC_PER_US      ((uint32_t)(CPU_CLOCK_HZ / 1000000UL))
+
+static void job_wait(qspi_job_state_t next, qspi_busy_op_t op,
+                     uint32_t busy_addr, uint32_t busy_len)
+{
+    const qspi_busy_timing_t *t = &s_job.ops->timing[op];
+
+    s_job.busy_addr   = busy_addr;
+    s_job.busy_len    = busy_len;
+    s_job.state       = next;
+    s_job.op          = op;
+    s_job.busy_cyc    = 0U;
+    s_job.last_cyc    = DWT->CYCCNT;
+    s_job.next_poll   = (uint64_t)t->typ_us * JOB_CYC_PER_US;
+    s_job.limit       = (uint64_t)t->max_us * JOB_CYC_PER_US;
+    s_job.interval_us = QSPI_HW_POLL_MIN_US;
+    s_job.ready       = false;
+}
+
+static void job_account(void)
+{
+    uint32_t now = DWT->CYCCNT;
+    s_job.busy_cyc += (uint32_t)(now - s_job.last_cyc);
+    s_job.last_cyc  = now;
+}
+
+/*
+ * Returns 1 = still busy, 0 = ready, -1 = error/timeout. No status read
+ * before the typical time of the operation, then reads with exponential
+ * backoff (same schedule as QSPI_HW_WaitReady), so most calls cost nothing.
+ */
+static int job_poll_busy(void)
+{
+    uint8_t sr = 0U;
+
+    if (s_job.ready)
+        return 0;
+
+    job_account();
+    if ((s_job.busy_cyc < s_job.next_poll) && (s_job.busy_cyc < s_job.limit))
+        return 1;
+
+    if (!s_job.ops->read_status(&sr))
+        return -1;
+
+    uint32_t us = (uint32_t)(s_job.busy_cyc / JOB_CYC_PER_US);
+
+    if ((sr & QSPI_JOB_SR_WIP_Msk) == 0U)
+    {
+        s_job.ready = true;
+        QSPI_HW_Stats_AddOp(s_job.op, us, true);
+        return 0;
+    }
+
+    if (s_job.busy_cyc >= s_job.limit)
+    {
+        QSPI_HW_Stats_AddOp(s_job.op, us, false);
+        printf("[QSPI_JOB] %s timeout after %lu us SR=0x%02X\r\n",
+               QSPI_HW_Stats_BusyOpName(s_job.op), (unsigned long)us, (unsigned)sr);
+        return -1;
+    }
+
+    s_job.next_poll = s_job.busy_cyc + ((uint64_t)s_job.interval_us * JOB_CYC_PER_US);
+    s_job.interval_us = (s_job.interval_us >= (QSPI_HW_POLL_MAX_US / 2U)) ? QSPI_HW_POLL_MAX_US
+                                                                         : (s_job.interval_us * 2U);
+    return 1;
+}
+
+/* Skip finished/empty segments; false when all are done */
+static bool job_next_seg(void)
+{
+    while (s_job.seg < s_job.nseg)
+    {
+        if (s_job.off < s_job.segs[s_job.seg].len)
+            return true;
+        s_job.seg++;
+        s_job.off = 0U;
+    }
+    return false;
+}
+
+static void job_step_prog_issue(void)
+{
+    if (!job_next_seg())
+    {
+        if (s_job.verify && (s_job.nseg != 0U))
+        {
+            s_job.seg   = 0U;
+            s_job.off   = 0U;
+            s_job.state = JOB_VERIFY;
+        }
+        else
+        {
+            job_finish(true);
+        }
+        return;
+    }
+
+    const qspi_job_seg_t *sg = &s_job.segs[s_job.seg];
+    const uint32_t page = s_job.ops->page_size;
+    uint32_t addr  = sg->address + s_job.off;
+    uint32_t chunk = page - (addr % page);
+    if (chunk > (sg->len - s_job.off))
+        chunk = sg->len - s_job.off;
+
+    if (!s_job.ops->program((const uint8_t *)sg->data + s_job.off, chunk, addr))
+    {
+        job_finish(false);
+        return;
+    }
+
+    s_job.off += chunk;
+    job_wait(JOB_PROG_WAIT, QSPI_BUSY_PAGE_PROG, addr, chunk);
+}
+
+uint32_t QSPI_Job_EraseUnit(const qspi_flash_ops_t *ops, uint32_t addr, uint32_t end)
+{
+    if ((ops->block_fit != NULL) && (ops->erase_block != NULL) && (end > addr))
+    {
+        uint32_t bsz = ops->block_fit(addr, end - addr);
+        if (bsz > ops->sector_size)
+            return bsz;
+    }
+    return ops->sector_size;
+}
+
+#if QSPI_JOB_BLANK_CHECK
+/* New byte for addr if a segment covers it */
+static bool job_seg_byte(uint32_t addr, uint8_t *val)
+{
+    for (uint32_t i = 0; i < s_job.nseg; i++)
+    {
+        const qspi_job_seg_t *sg = &s_job.segs[i];
+        if ((addr - sg->address) < sg->len)
+        {
+            *val = ((const uint8_t *)sg->data)[addr - sg->address];
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Blank-check and verify reads sweep whole erase units and segments once:
+ * straight from the flash, so they do not evict the read cache's hot lines
+ * (and verify checks the flash itself) */
+static inline bool job_read(void *rx, uint32_t len, uint32_t addr)
+{
+#if QSPI_CACHE_ENABLE
+    return QSPI_Cache_ReadThrough(rx, len, addr);
+#else
+    return s_job.ops->read(rx, len, addr);
+#endif
+}
+
+/* One chunk of the current erase unit: false if it needs the erase */
+static bool job_blank_chunk_ok(uint32_t addr, uint32_t n)
+{
+    uint8_t rb[QSPI_JOB_BLANK_CHUNK];
+
+    if (!job_read(rb, n, addr))
+        return false;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        uint8_t nv;
+        if (job_seg_byte(addr + i, &nv))
+        {
+            if ((uint8_t)(rb[i] & nv) != nv)
+                return false;
+        }
+        else if (rb[i] != 0xFFU)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+static void job_step_erase_issue(void)
+{
+    const qspi_flash_ops_t *ops = s_job.ops;
+    uint32_t unit = s_job.erase_unit;
+    bool ok;
+
+    if (unit > ops->sector_size)
+    {
+        ok = ops->erase_block(s_job.erase_addr, unit);
+        s_stats.block_erases++;
+    }
+    else
+    {
+        ok = ops->erase_sector(s_job.erase_addr);
+        s_stats.sector_erases++;
+    }
+
+    if (!ok)
+    {
+        job_finish(false);
+        return;
+    }
+
+    job_wait(JOB_ERASE_WAIT,
+             (unit > ops->sector_size) ? QSPI_BUSY_BLOCK_ERASE : QSPI_BUSY_SECTOR_ERASE,
+             s_job.erase_addr, unit);
+}
+
+static void job_step_verify(void)
+{
+    uint8_t rb[QSPI_JOB_VERIFY_CHUNK];
+
+    if (!job_next_seg())
+    {
+        job_finish(true);
+        return;
+    }
+
+    const qspi_job_seg_t *sg = &s_job.segs[s_job.seg];
+    uint32_t n = sg->len - s_job.off;
+    if (n > sizeof(rb))
+        n = sizeof(rb);
+
+    if (!job_read(rb, n, sg->address + s_job.off) ||
+        (memcmp(rb, (const uint8_t *)sg->data + s_job.off, n) != 0))
+    {
+        job_finish(false);
+        return;
+    }
+
+    s_job.off += n;
+}
+
+void QSPI_Job_Task(void)
+{
+    int busy;
+
+    if (s_job.suspended)
+        return;
+
+    switch (s_job.state)
+    {
+        case JOB_IDLE:
+            break;
+
+        case JOB_ERASE_ISSUE:
+            if (s_job.erase_addr >= s_job.erase_end)
+            {
+                s_job.state = JOB_PROG_ISSUE;
+                break;
+            }
+            s_job.erase_unit = QSPI_Job_EraseUnit(s_job.ops, s_job.erase_addr, s_job.erase_end);
+#if QSPI_JOB_BLANK_CHECK
+            if (!QSPI_HW_Scramble_Overlaps(s_job.erase_addr, s_job.erase_unit))
+            {
+                s_job.blank_off = 0U;
+                s_job.state = JOB_BLANK_CHECK;
+                break;
+            }
+#endif
+            job_step_erase_issue();
+            break;
+
+#if QSPI_JOB_BLANK_CHECK
+        case JOB_BLANK_CHECK:
+        {
+            uint32_t n = s_job.erase_unit - s_job.blank_off;
+            if (n > QSPI_JOB_BLANK_CHUNK)
+                n = QSPI_JOB_BLANK_CHUNK;
+
+            if (!job_blank_chunk_ok(s_job.erase_addr + s_job.blank_off, n))
+            {
+                job_step_erase_issue();
+                break;
+            }
+
+            s_job.blank_off += n;
+            if (s_job.blank_off >= s_job.erase_unit)
+            {
+                s_stats.erase_skips++;
+                s_job.erase_addr += s_job.erase_unit;
+                s_job.state = JOB_ERASE_ISSUE;
+            }
+            break;
+        }
+#endif
+
+        case JOB_ERASE_WAIT:
+            busy = job_poll_busy();
+            if (busy < 0)
+            {
+                job_finish(false);
+            }
+            else if (busy == 0)
+            {
+#if QSPI_WEAR_ENABLE
+                QSPI_Wear_NoteErase(s_job.erase_addr, s_job.erase_unit);
+#endif
+#if QSPI_LOG_ENABLE
+                QSPI_Log_NoteErase(s_job.erase_addr, s_job.erase_unit);
+#endif
+#if QSPI_FLASH_INDEX
+                QSPI_Flash_NoteErase(s_job.erase_addr, s_job.erase_unit);
+#endif
+                s_job.erase_addr += s_job.erase_unit;
+                s_job.state = JOB_ERASE_ISSUE;
+            }
+            break;
+
+        case JOB_PROG_ISSUE:
+            job_step_prog_issue();
+            break;
+
+        case JOB_PROG_WAIT:
+            busy = job_poll_busy();
+            if (busy < 0)
+                job_finish(false);
+            else if (busy == 0)
+                s_job.state = JOB_PROG_ISSUE;
+            break;
+
+        case JOB_VERIFY:
+            job_step_verify();
+            break;
+
+        case JOB_CHIP_WAIT:
+            busy = job_poll_busy();
+            if (busy <= 0)
+            {
+                if (busy == 0)
+                {
+                    printf("[QSPI_JOB] chip erase done in %lu ms\r\n",
+                           (unsigned long)(s_job.busy_cyc / (JOB_CYC_PER_US * 1000UL)));
+#if QSPI_WEAR_ENABLE
+                    QSPI_Wear_NoteErase(0U, s_job.ops->capacity);
+#endif
+#if QSPI_LOG_ENABLE
+                    QSPI_Log_NoteErase(0U, s_job.ops->capacity);
+#endif
+#if QSPI_FLASH_INDEX
+                    QSPI_Flash_NoteErase(0U, s_job.ops->capacity);
+#endif
+                }
+                job_finish(busy == 0);
+            }
+            break;
+
+        default:
+            job_finish(false);
+            break;
+    }
+}
+
+bool QSPI_Job_Write(uint32_t erase_addr, uint32_t erase_len,
+                    const qspi_job_seg_t *segs, uint32_t nseg,
+                    bool verify,
+                    qspi_job_cb_t cb, void *ctx)
+{
+    const qspi_flash_ops_t *ops = QSPI_Flash_Ops();
+
+    if ((ops == NULL) || (s_job.state != JOB_IDLE) || (nseg > QSPI_JOB_MAX_SEGS) ||
+        ((nseg != 0U) && (segs == NULL)))
+        return false;
+
+    const uint32_t sector = ops->sector_size;
+    uint32_t start = erase_addr & ~(sector - 1U);
+    uint32_t end   = (erase_len == 0U) ? start
+                   : ((erase_addr + erase_len + (sector - 1U)) & ~(sector - 1U));
+
+    if (end > ops->capacity)
+        return false;
+
+    for (uint32_t i = 0; i < nseg; i++)
+    {
+        if ((segs[i].data == NULL) && (segs[i].len != 0U))
+            return false;
+        if ((segs[i].address + segs[i].len) > ops->capacity)
+            return false;
+    }
+
+    memset(&s_job, 0, sizeof(s_job));
+    s_job.ops        = ops;
+    s_job.erase_addr = start;
+    s_job.erase_end  = end;
+    if (nseg != 0U)
+        memcpy(s_job.segs, segs, nseg * sizeof(segs[0]));
+    s_job.nseg       = nseg;
+    s_job.verify     = verify;
+    s_job.cb         = cb;
+    s_job.ctx        = ctx;
+    s_job.state      = JOB_ERASE_ISSUE;
+    return true;
+}
+
+bool QSPI_Job_ChipErase(qspi_job_cb_t cb, void *ctx)
+{
+    const qspi_flash_ops_t *ops = QSPI_Flash_Ops();
+
+    if ((ops == NULL) || (s_job.state != JOB_IDLE) || (ops->chip_erase_start == NULL))
+        return false;
+
+    memset(&s_job, 0, sizeof(s_job));
+    s_job.ops = ops;
+    s_job.cb  = cb;
+    s_job.ctx = ctx;
+
+    if (!ops->chip_erase_start())
+        return false;
+
+    job_wait(JOB_CHIP_WAIT, QSPI_BUSY_CHIP_ERASE, 0U, ops->capacity);
+    return true;
+}
+
+bool QSPI_Job_IsBusy(void)
+{
+    return (s_job.state != JOB_IDLE);
+}
+
+bool QSPI_Job_Suspend(uint32_t addr, uint32_t len)
+{
+    const qspi_flash_ops_t *ops = s_job.ops;
+
+    if ((s_job.state != JOB_ERASE_WAIT) && (s_job.state != JOB_PROG_WAIT))
+    {
+        /* Idle, between steps, or chip erase (cannot be suspended) */
+        if (s_job.state == JOB_CHIP_WAIT)
+        {
+            s_stats.conflicts++;
+            return false;
+        }
+        return true;
+    }
+
+    if ((addr < (s_job.busy_addr + s_job.busy_len)) && (s_job.busy_addr < (addr + len)))
+    {
+        s_stats.conflicts++;
+        return false;
+    }
+
+    /* Nested (e.g. a read from a callback): already suspended, no second 75h/B0h */
+    if (s_job.suspended)
+    {
+        s_job.suspend_depth++;
+        return true;
+    }
+
+    if ((ops->suspend == NULL) || (ops->resume == NULL))
+    {
+        /* No suspend: the read has to wait for the operation */
+        int busy;
+        while ((busy = job_poll_busy()) > 0)
+        {
+        }
+        return (busy == 0);
+    }
+
+    /* Let the erase make progress after the previous resume */
+    const uint32_t min_cyc = QSPI_JOB_RESUME_MIN_US * (uint32_t)(CPU_CLOCK_HZ / 1000000UL);
+    if (s_resume_valid && ((DWT->CYCCNT - s_resume_cyc) < min_cyc))
+    {
+        s_stats.resume_holdoffs++;
+        while ((DWT->CYCCNT - s_resume_cyc) < min_cyc)
+        {
+        }
+    }
+
+    uint32_t c0 = DWT->CYCCNT;
+    if (!ops->suspend())
+        return false;
+    uint32_t dc = DWT->CYCCNT - c0;
+
+    job_account();
+    s_job.suspended = true;
+    s_stats.suspends++;
+    if (dc > s_stats.max_suspend_cycles)
+        s_stats.max_suspend_cycles = dc;
+    return true;
+}
+
+void QSPI_Job_Resume(void)
+{
+    if (!s_job.suspended)
+        return;
+
+    /* Only the outermost resume restarts the operation */
+    if (s_job.suspend_depth != 0U)
+    {
+        s_job.suspend_depth--;
+        return;
+    }
+
+    if (!s_job.ops->resume())
+        printf("[QSPI_JOB] resume failed\r\n");
+
+    /* Time spent suspended does not count against the operation timeout */
+    s_job.last_cyc  = DWT->CYCCNT;
+    s_job.suspended = false;
+    s_resume_cyc    = DWT->CYCCNT;
+    s_resume_valid  = true;
+}
+
+void QSPI_Job_GetStats(qspi_job_stats_t *out)
+{
+    if (out != NULL)
+        *out = s_stats;
+}
+
+bool QSPI_Job_LastResult(void)
+{
+    return s_last_ok;
+}
+
+void QSPI_Job_SetIdleHook(void (*hook)(void))
+{
+    s_idle_hook = hook;
+}
+
+bool QSPI_Job_Wait(void)
+{
+    while (s_job.state != JOB_IDLE)
+    {
+        QSPI_Job_Task();
+
+        if (s_idle_hook != NULL)
+            s_idle_hook();
+    }
+    return s_last_ok;
+}
@@ -0,0 +1,117 @@
+/* qspi_job.h: Non-blocking flash job engine (erase / program / verify)
+ *
+ * A job is a sector-erase range, up to QSPI_JOB_MAX_SEGS program segments and
+ * an optional read-back verify. QSPI_Job_Task() advances it by one bounded
+ * step per call (issue one erase, poll WIP once, program one page, compare one
+ * chunk), so it can run from the superloop next to the LED/button/log tasks.
+ * Completion is reported through the callback (called from QSPI_Job_Task()).
+ *
+ * One job at a time. Segment data must stay valid until the callback runs.
+ * QSPI_Job_Task() must not be called from an ISR. Reads may run while a job
+ * is busy if they are bracketed by QSPI_Job_Suspend()/QSPI_Job_Resume()
+ * (QSPI_Flash_ReadAddr does this): an in-flight sector erase or page program
+ * is suspended, so the read waits for the suspend latency (~10-30 us)
+ * instead of the rest of the erase.
+ */
+
+#ifndef QSPI_JOB_H
+#define QSPI_JOB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "qspi_flash_ops.h"
+
+#define QSPI_JOB_MAX_SEGS               (2U)
+
+/* Bytes compared per QSPI_Job_Task() call during verify / blank check */
+#define QSPI_JOB_VERIFY_CHUNK           (64U)
+#define QSPI_JOB_BLANK_CHUNK            (256U)
+
+/*
+ * 1 = read each erase unit before erasing it and skip the erase when the new
+ * data can be programmed over what is stored: bytes outside the segments
+ * are 0xFF and segment bytes only clear bits ((old & new) == new). The
+ * result is the same as erase + program. Scrambled units are always erased
+ * (erased flash does not descramble to 0xFF).
+ */
+#ifndef QSPI_JOB_BLANK_CHECK
+#define QSPI_JOB_BLANK_CHECK            1
+#endif
+
+/* Status polls follow ops->timing: first read at the typical time of the
+ * operation, then exponential backoff; timeout at timing max (DWT time,
+ * suspended time excluded). Durations go to the QSPI_HW busy-op stats. */
+
+/* Minimum run time after a resume before the next suspend, so back-to-back
+ * reads cannot starve the erase */
+#define QSPI_JOB_RESUME_MIN_US              (200U)
+
+typedef void (*qspi_job_cb_t)(bool ok, void *ctx);
+
+typedef struct
+{
+    uint32_t suspends;              /* erase/program actually suspended */
+    uint32_t max_suspend_cycles;    /* worst command-to-readable latency (DWT) */
+    uint32_t resume_holdoffs;       /* suspends delayed by QSPI_JOB_RESUME_MIN_US */
+    uint32_t conflicts;             /* reads refused (target range in flight) */
+    uint32_t sector_erases;
+    uint32_t block_erases;
+    uint32_t erase_skips;           /* units the blank check found programmable */
+} qspi_job_stats_t;
+
+typedef struct
+{
+    uint32_t    address;
+    const void *data;
+    uint32_t    len;
+} qspi_job_seg_t;
+
+/*
+ * Erase [erase_addr, erase_addr + erase_len) rounded out to sectors
+ * (erase_len 0 = no erase), program the segments page by page, then
+ * optionally read them back. cb may be NULL.
+ * The erase follows QSPI_Job_EraseUnit(): block erases where a whole block
+ * lies inside the range, sector erases at the unaligned edges.
+ */
+bool QSPI_Job_Write(uint32_t erase_addr, uint32_t erase_len,
+                    const qspi_job_seg_t *segs, uint32_t nseg,
+                    bool verify,
+                    qspi_job_cb_t cb, void *ctx);
+
+bool QSPI_Job_ChipErase(qspi_job_cb_t cb, void *ctx);
+
+/*
+ * Erase planner: size of the next erase at addr (sector-aligned) for a range
+ * ending at end, i.e. the largest block erase that fits, else one sector.
+ * Walking the range with it gives the fewest erase commands.
+ */
+uint32_t QSPI_Job_EraseUnit(const qspi_flash_ops_t *ops, uint32_t addr, uint32_t end);
+
+/* Superloop step; returns quickly when idle */
+void QSPI_Job_Task(void);
+
+bool QSPI_Job_IsBusy(void);
+
+/*
+ * Make the flash readable for [addr, addr + len). Returns false if the
+ * range is being erased/programmed right now, or a chip erase runs (not
+ * suspendable). Parts without suspend wait for the operation to finish.
+ * Every successful call must be paired with QSPI_Job_Resume(). Calls may
+ * nest: only the outermost pair suspends and resumes the flash.
+ */
+bool QSPI_Job_Suspend(uint32_t addr, uint32_t len);
+void QSPI_Job_Resume(void);
+void QSPI_Job_GetStats(qspi_job_stats_t *out);
+/* Result of the last finished job */
+bool QSPI_Job_LastResult(void);
+
+/*
+ * Blocking helper: runs QSPI_Job_Task() and the idle hook until the job ends.
+ * The idle hook is where the application keeps its own tasks alive
+ * (it must not touch the QSPI flash).
+ */
+bool QSPI_Job_Wait(void);
+void QSPI_Job_SetIdleHook(void (*hook)(void));
+
+#endif /* QSPI_JOB_H */
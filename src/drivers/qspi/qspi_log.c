@@ -0,0 +1,1688 @@
+/* qspi_log.c: Log-structured (append-only) object store */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include "../../common/board.h"
+#include "../../common/systick.h"
+#include "qspi_log.h"
+#include "qspi_job.h"
+#include "qspi_crc32.h"
+#include "qspi_crc_hw.h"
+#include "qspi_wear.h"
+#include "qspi_index.h"
+
+#if QSPI_LOG_ENABLE
+
+#define LOG_HDR_SIZE        ((uint32_t)sizeof(qspi_log_hdr_t))
+#define LOG_ERASED_WORD     (0xFFFFFFFFUL)
+#define LOG_COPY_CHUNK      (256U)
+#define LOG_FLAGS_OFF       ((uint32_t)offsetof(qspi_obj_hdr_t, flags))
+
+_Static_assert(sizeof(qspi_log_hdr_t) == 32U, "log header layout");
+_Static_assert((QSPI_LOG_BASE % QSPI_LOG_SEG_SIZE) == 0U, "log base not segment aligned");
+_Static_assert((QSPI_LOG_CKPT_SIZE % QSPI_LOG_SEG_SIZE) == 0U, "checkpoint area not segment aligned");
+_Static_assert((QSPI_LOG_INDEX_SLOTS & (QSPI_LOG_INDEX_SLOTS - 1U)) == 0U,
+               "QSPI_LOG_INDEX_SLOTS must be a power of two");
+
+typedef enum
+{
+    SEG_FREE = 0,           /* erased (verified when opened) */
+    SEG_OPEN,               /* receiving small records */
+    SEG_USED,               /* small records, closed */
+    SEG_SPAN,               /* first segment of one large record */
+    SEG_CONT,               /* rest of a span */
+    SEG_DIRTY,              /* unknown content, erase before use */
+} log_seg_state_t;
+
+typedef struct
+{
+    uint8_t  state;
+    uint8_t  span;          /* SEG_SPAN: segments the record covers */
+    uint16_t used;          /* bytes holding records */
+    uint32_t seq_min;       /* oldest record in the segment (0 = none) */
+    uint32_t seq_max;       /* newest record in the segment */
+} log_seg_t;
+
+static log_seg_t s_seg[QSPI_LOG_SEGS];
+static qspi_index_entry_t s_index_slots[QSPI_LOG_INDEX_SLOTS];
+static qspi_index_t       s_index;
+static bool      s_mounted;
+static int32_t   s_open = -1;
+static uint32_t  s_next_seq;
+static qspi_log_stats_t s_stats;
+static uint16_t  s_live[QSPI_LOG_SEGS];    /* bytes of current records, from the index */
+
+__attribute__((aligned(4)))
+static uint8_t   s_copy_buf[LOG_COPY_CHUNK];
+
+static inline uint32_t log_seg_addr(uint32_t seg)
+{
+    return QSPI_LOG_DATA_BASE + (seg * QSPI_LOG_SEG_SIZE);
+}
+
+static inline uint32_t log_seg_of(uint32_t addr)
+{
+    return (addr - QSPI_LOG_DATA_BASE) / QSPI_LOG_SEG_SIZE;
+}
+
+static inline uint32_t log_rec_size(uint32_t payload_len)
+{
+    return (LOG_HDR_SIZE + payload_len + (QSPI_LOG_ALIGN - 1U)) & ~(QSPI_LOG_ALIGN - 1U);
+}
+
+static inline bool log_committed(const qspi_log_hdr_t *h)
+{
+    return (h->obj.flags & QSPI_LOG_FLAG_UNCOMMITTED) == 0U;
+}
+
+static inline bool log_is_delete(const qspi_log_hdr_t *h)
+{
+    return (h->obj.flags & QSPI_LOG_FLAG_DATA) == 0U;
+}
+
+static uint32_t log_hdr_crc(const qspi_log_hdr_t *h)
+{
+    qspi_log_hdr_t t = *h;
+    t.obj.flags |= QSPI_LOG_FLAG_UNCOMMITTED;
+    t.obj.header_crc = 0U;
+    return QSPI_CRC32(&t, sizeof(t));
+}
+
+static bool log_hdr_valid(const qspi_log_hdr_t *h)
+{
+    return (h->obj.magic == QSPI_LOG_MAGIC) &&
+           (h->obj.header_len == (uint16_t)LOG_HDR_SIZE) &&
+           (log_hdr_crc(h) == h->obj.header_crc);
+}
+
+static bool log_read_hdr(uint32_t addr, qspi_log_hdr_t *h)
+{
+    return QSPI_Flash_ReadData(addr, h, LOG_HDR_SIZE, NULL);
+}
+
+static bool log_blank(uint32_t addr, uint32_t len)
+{
+    while (len != 0U)
+    {
+        uint32_t n = (len > LOG_COPY_CHUNK) ? LOG_COPY_CHUNK : len;
+        if (!QSPI_Flash_ReadData(addr, s_copy_buf, n, NULL))
+            return false;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            if (s_copy_buf[i] != 0xFFU)
+                return false;
+        }
+        addr += n;
+        len -= n;
+    }
+    return true;
+}
+
+/* Blocking job; waits out a background job (wear flush, async write) first */
+static bool log_job(uint32_t erase_addr, uint32_t erase_len,
+                    const qspi_job_seg_t *segs, uint32_t nseg)
+{
+    if (QSPI_Job_IsBusy())
+        (void)QSPI_Job_Wait();
+    return QSPI_Job_Write(erase_addr, erase_len, segs, nseg, (nseg != 0U), NULL, NULL) &&
+           QSPI_Job_Wait();
+}
+
+static bool log_gc_opening(uint32_t seg);
+
+static uint32_t log_free_count(void)
+{
+    uint32_t n = 0U;
+    for (uint32_t i = 0; i < QSPI_LOG_SEGS; i++)
+    {
+        if ((s_seg[i].state == SEG_FREE) && !log_gc_opening(i))
+            n++;
+    }
+    return n;
+}
+
+/* ---------------- record walk ---------------- */
+
+typedef bool (*log_visit_t)(uint32_t addr, const qspi_log_hdr_t *h, void *ctx);
+
+/* Visit the valid headers of one segment in address order; false = stopped */
+static bool log_walk_seg(uint32_t seg, log_visit_t fn, void *ctx)
+{
+    const log_seg_t *s = &s_seg[seg];
+    qspi_log_hdr_t h;
+    uint32_t end;
+
+    if ((s->state == SEG_OPEN) || (s->state == SEG_USED))
+        end = s->used;
+    else if (s->state == SEG_SPAN)
+        end = 1U;                   /* the one record at offset 0 */
+    else
+        return true;
+
+    for (uint32_t off = 0; off < end; off += log_rec_size(h.obj.payload_len))
+    {
+        if (!log_read_hdr(log_seg_addr(seg) + off, &h) || !log_hdr_valid(&h))
+            break;                  /* torn tail, nothing valid behind it */
+        if (!fn(log_seg_addr(seg) + off, &h, ctx))
+            return false;
+    }
+    return true;
+}
+
+static void log_walk(log_visit_t fn, void *ctx)
+{
+    for (uint32_t seg = 0; seg < QSPI_LOG_SEGS; seg++)
+    {
+        if (!log_walk_seg(seg, fn, ctx))
+            return;
+    }
+}
+
+/* Index entry of h at addr, if h is the newest committed record of its type */
+static const qspi_index_entry_t *log_indexed(uint32_t addr, const qspi_log_hdr_t *h)
+{
+    const qspi_index_entry_t *e = QSPI_Index_Get(&s_index, h->obj.type_id);
+    return ((e != NULL) && (e->address == addr) && log_committed(h)) ? e : NULL;
+}
+
+/* Could a record older than seq exist outside segment skip? */
+static bool log_older_exists(uint32_t seq, uint32_t skip)
+{
+    for (uint32_t i = 0; i < QSPI_LOG_SEGS; i++)
+    {
+        const log_seg_t *s = &s_seg[i];
+        if ((i != skip) && (s->seq_min != 0U) && (s->seq_min < seq) &&
+            ((s->state == SEG_OPEN) || (s->state == SEG_USED) || (s->state == SEG_SPAN)))
+            return true;
+    }
+    return false;
+}
+
+/*
+ * A record must survive GC if the index points at it (newest committed one
+ * of its type). A delete marker only while an older record of the type may
+ * still be on flash outside its own segment, judged by the segments' oldest
+ * sequence numbers.
+ */
+static bool log_rec_live(uint32_t addr, const qspi_log_hdr_t *h)
+{
+    if (log_indexed(addr, h) == NULL)
+        return false;
+    return !log_is_delete(h) ||
+           log_older_exists(h->seq, log_seg_of(addr));
+}
+
+/* Bytes a record holds in its first segment (a span fills it) */
+static inline uint32_t log_seg_bytes(uint32_t payload_len)
+{
+    uint32_t rec = log_rec_size(payload_len);
+    return (rec > QSPI_LOG_SEG_SIZE) ? QSPI_LOG_SEG_SIZE : rec;
+}
+
+static void log_live_sub(const qspi_index_entry_t *e)
+{
+    uint16_t *live = &s_live[log_seg_of(e->address)];
+    uint32_t n = log_seg_bytes(e->len);
+    *live = (*live > n) ? (uint16_t)(*live - n) : 0U;
+}
+
+/* Index changes go through here so s_live (the GC victim score) follows */
+static bool log_index_put(uint32_t addr, const qspi_log_hdr_t *h)
+{
+    const qspi_index_entry_t *old = QSPI_Index_Get(&s_index, h->obj.type_id);
+    const qspi_index_entry_t e =
+    {
+        h->obj.type_id, addr, h->obj.payload_len, h->obj.version, h->seq,
+        log_is_delete(h) ? QSPI_INDEX_F_DELETED : 0U
+    };
+
+    if (old != NULL)
+        log_live_sub(old);
+    if (!QSPI_Index_Put(&s_index, &e))
+        return false;
+    s_live[log_seg_of(addr)] = (uint16_t)(s_live[log_seg_of(addr)] + log_seg_bytes(e.len));
+    return true;
+}
+
+static void log_index_drop(uint32_t type_id)
+{
+    const qspi_index_entry_t *old = QSPI_Index_Get(&s_index, type_id);
+    if (old != NULL)
+    {
+        log_live_sub(old);
+        (void)QSPI_Index_Remove(&s_index, type_id);
+    }
+}
+
+/* Recount s_live from the index (after mount) */
+static void log_live_rebuild(void)
+{
+    memset(s_live, 0, sizeof(s_live));
+    for (uint32_t i = 0; i < QSPI_LOG_INDEX_SLOTS; i++)
+    {
+        const qspi_index_entry_t *e = &s_index_slots[i];
+        if (e->address != QSPI_INDEX_EMPTY)
+            s_live[log_seg_of(e->address)] = (uint16_t)(s_live[log_seg_of(e->address)] + log_seg_bytes(e->len));
+    }
+}
+
+/* ---------------- checkpoint + journal ---------------- */
+
+/*
+ * Checkpoint area (two, used in turn):
+ *   [log_ckpt_hdr_t][..][s_seg table][index slots][..][journal: log_jrnl_t x N]
+ * The tables are programmed first and the header last, so a checkpoint
+ * without a valid header was never finished. Every segment state change
+ * that is not visible from the records themselves (open, span, erase) is
+ * journaled before it happens; mount loads the newest checkpoint, replays
+ * the journal and scans only the segments opened since.
+ */
+#define LOG_CKPT_MAGIC      (0x314B434CUL)  /* 'LCK1' */
+#define LOG_CKPT_SEG_OFF    (256UL)
+#define LOG_CKPT_IDX_OFF    (LOG_CKPT_SEG_OFF + (uint32_t)sizeof(s_seg))
+#define LOG_JRNL_ENTRIES    QSPI_LOG_JRNL_ENTRIES
+#define LOG_JRNL_OFF        (QSPI_LOG_CKPT_SIZE - (LOG_JRNL_ENTRIES * (uint32_t)sizeof(log_jrnl_t)))
+#define LOG_LAYOUT          (((uint32_t)sizeof(log_seg_t) << 16) | (uint32_t)sizeof(qspi_index_entry_t))
+
+typedef struct __attribute__((packed))
+{
+    uint32_t magic;
+    uint32_t gen;
+    uint32_t next_seq;
+    uint16_t segs;
+    uint16_t slots;
+    int16_t  open;
+    uint16_t reserved;
+    uint32_t layout;
+    uint32_t seg_crc;
+    uint32_t index_crc;
+    uint32_t hdr_crc;
+} log_ckpt_hdr_t;
+
+typedef enum
+{
+    JRNL_OPEN = 1,          /* seg became the open segment */
+    JRNL_SPAN,              /* seg..seg+n-1 reserved for one record */
+    JRNL_ERASE,             /* seg..seg+n-1 about to be erased */
+} log_jrnl_op_t;
+
+typedef struct __attribute__((packed))
+{
+    uint8_t  op;
+    uint8_t  n;
+    uint16_t seg;
+    uint32_t seq;           /* s_next_seq when logged */
+    uint32_t gen;           /* checkpoint it belongs to */
+    uint32_t crc;
+} log_jrnl_t;
+
+_Static_assert(sizeof(log_jrnl_t) == 16U, "journal entry layout");
+_Static_assert((LOG_CKPT_IDX_OFF + sizeof(s_index_slots)) <= LOG_JRNL_OFF,
+               "checkpoint tables and journal do not fit QSPI_LOG_CKPT_SIZE");
+_Static_assert((LOG_JRNL_OFF % LOG_COPY_CHUNK) == 0U, "journal not chunk aligned");
+
+static int32_t  s_ckpt_area = -1;   /* area holding the current checkpoint */
+static uint32_t s_ckpt_gen;
+static uint32_t s_jrnl_next;        /* next free journal slot */
+static int32_t  s_ckpt_blank = -1;  /* area erased ahead by QSPI_Log_Task */
+static volatile bool s_ckpt_spare_busy;
+
+static inline uint32_t log_ckpt_addr(uint32_t area)
+{
+    return QSPI_LOG_BASE + (area * QSPI_LOG_CKPT_SIZE);
+}
+
+static uint32_t log_ckpt_hdr_crc(const log_ckpt_hdr_t *h)
+{
+    return QSPI_CRC32(h, offsetof(log_ckpt_hdr_t, hdr_crc));
+}
+
+static void log_gc_settle(void);
+
+/* Snapshot the segment table and the index into the other area */
+static bool log_ckpt_write(void)
+{
+    const uint32_t area = (s_ckpt_area == 0) ? 1U : 0U;
+    const uint32_t base = log_ckpt_addr(area);
+    log_ckpt_hdr_t h;
+
+    log_gc_settle();
+
+    const qspi_job_seg_t tables[2] =
+    {
+        { base + LOG_CKPT_SEG_OFF, s_seg,         (uint32_t)sizeof(s_seg) },
+        { base + LOG_CKPT_IDX_OFF, s_index_slots, (uint32_t)sizeof(s_index_slots) },
+    };
+    if (((s_ckpt_blank != (int32_t)area) && !log_job(base, QSPI_LOG_CKPT_SIZE, NULL, 0U)) ||
+        !log_job(0U, 0U, tables, 2U))
+        return false;
+    s_ckpt_blank = -1;
+
+    h.magic     = LOG_CKPT_MAGIC;
+    h.gen       = s_ckpt_gen + 1U;
+    h.next_seq  = s_next_seq;
+    h.segs      = (uint16_t)QSPI_LOG_SEGS;
+    h.slots     = (uint16_t)QSPI_LOG_INDEX_SLOTS;
+    h.open      = (int16_t)s_open;
+    h.reserved  = 0xFFFFU;
+    h.layout    = LOG_LAYOUT;
+    h.seg_crc   = QSPI_CRC_HW_Buffer(s_seg, sizeof(s_seg));
+    h.index_crc = QSPI_CRC_HW_Buffer(s_index_slots, sizeof(s_index_slots));
+    h.hdr_crc   = log_ckpt_hdr_crc(&h);
+
+    const qspi_job_seg_t hseg = { base, &h, (uint32_t)sizeof(h) };
+    if (!log_job(0U, 0U, &hseg, 1U))
+        return false;
+
+    s_ckpt_area = (int32_t)area;
+    s_ckpt_gen  = h.gen;
+    s_jrnl_next = 0U;
+    s_stats.ckpt_writes++;
+    return true;
+}
+
+/* No checkpoint yet, or its journal is full: the next entry needs a new one */
+static bool log_jrnl_full(void)
+{
+    return (s_ckpt_area < 0) || (s_jrnl_next >= LOG_JRNL_ENTRIES);
+}
+
+/* Fill in a journal entry and take its slot; returns the slot address */
+static uint32_t log_jrnl_entry(log_jrnl_t *j, log_jrnl_op_t op, uint32_t seg, uint32_t n)
+{
+    const uint32_t addr = log_ckpt_addr((uint32_t)s_ckpt_area) + LOG_JRNL_OFF +
+                          (s_jrnl_next * (uint32_t)sizeof(*j));
+
+    j->op  = (uint8_t)op;
+    j->n   = (uint8_t)n;
+    j->seg = (uint16_t)seg;
+    j->seq = s_next_seq;
+    j->gen = s_ckpt_gen;
+    j->crc = QSPI_CRC32(j, offsetof(log_jrnl_t, crc));
+
+    s_jrnl_next++;                  /* a failed slot is not reused */
+    return addr;
+}
+
+/* Journal a segment state change before it is made; a full journal (or no
+ * checkpoint yet) starts a new checkpoint first */
+static bool log_jrnl(log_jrnl_op_t op, uint32_t seg, uint32_t n)
+{
+    log_jrnl_t j;
+
+    if (log_jrnl_full() && !log_ckpt_write())
+    {
+        printf("[QSPI_LOG] checkpoint write failed\r\n");
+        return false;
+    }
+
+    const qspi_job_seg_t jseg = { log_jrnl_entry(&j, op, seg, n), &j, (uint32_t)sizeof(j) };
+    return log_job(0U, 0U, &jseg, 1U);
+}
+
+/* Newest checkpoint with intact tables into s_seg / s_index */
+static bool log_ckpt_load(void)
+{
+    log_ckpt_hdr_t h[2];
+    int32_t best = -1;
+
+    for (uint32_t a = 0; a < 2U; a++)
+    {
+        if (!QSPI_Flash_ReadData(log_ckpt_addr(a), &h[a], (uint32_t)sizeof(h[a]), NULL) ||
+            (h[a].magic != LOG_CKPT_MAGIC) || (h[a].hdr_crc != log_ckpt_hdr_crc(&h[a])) ||
+            (h[a].segs != QSPI_LOG_SEGS) || (h[a].slots != QSPI_LOG_INDEX_SLOTS) ||
+            (h[a].layout != LOG_LAYOUT))
+            continue;
+        if ((best < 0) || (h[a].gen > h[best].gen))
+            best = (int32_t)a;
+    }
+    if (best < 0)
+        return false;
+
+    /* an older checkpoint would miss the journal of the newer one: no fallback */
+    const log_ckpt_hdr_t *c = &h[best];
+    const uint32_t base = log_ckpt_addr((uint32_t)best);
+    uint32_t seg_crc, index_crc;
+    if (!QSPI_Flash_ReadData(base + LOG_CKPT_SEG_OFF, s_seg, (uint32_t)sizeof(s_seg), &seg_crc) ||
+        !QSPI_Flash_ReadData(base + LOG_CKPT_IDX_OFF, s_index_slots, (uint32_t)sizeof(s_index_slots), &index_crc) ||
+        (seg_crc != c->seg_crc) || (index_crc != c->index_crc))
+    {
+        memset(s_seg, 0, sizeof(s_seg));
+        return false;
+    }
+
+    QSPI_Index_Load(&s_index, s_index_slots, QSPI_LOG_INDEX_SLOTS);
+    s_next_seq  = c->next_seq;
+    s_open      = c->open;
+    s_ckpt_area = best;
+    s_ckpt_gen  = c->gen;
+    return true;
+}
+
+/* Apply the journal of the loaded checkpoint. order[] receives the
+ * segments to scan, oldest first. Returns false if the tail is torn. */
+static bool log_jrnl_replay(uint16_t *order, uint32_t *norder)
+{
+    const uint32_t base = log_ckpt_addr((uint32_t)s_ckpt_area) + LOG_JRNL_OFF;
+    const uint32_t per_chunk = LOG_COPY_CHUNK / (uint32_t)sizeof(log_jrnl_t);
+    bool intact = true;
+
+    *norder = 0U;
+    if (s_open >= 0)
+        order[(*norder)++] = (uint16_t)s_open;
+
+    for (s_jrnl_next = 0U; s_jrnl_next < LOG_JRNL_ENTRIES; s_jrnl_next++)
+    {
+        const log_jrnl_t *j = &((const log_jrnl_t *)s_copy_buf)[s_jrnl_next % per_chunk];
+
+        if (((s_jrnl_next % per_chunk) == 0U) &&
+            !QSPI_Flash_ReadData(base + (s_jrnl_next * (uint32_t)sizeof(log_jrnl_t)),
+                                 s_copy_buf, LOG_COPY_CHUNK, NULL))
+            return false;
+
+        if (j->crc == LOG_ERASED_WORD)
+            break;
+        if ((j->crc != QSPI_CRC32(j, offsetof(log_jrnl_t, crc))) || (j->gen != s_ckpt_gen) ||
+            ((uint32_t)j->seg + j->n > QSPI_LOG_SEGS))
+        {
+            intact = false;
+            break;
+        }
+        s_stats.mount_jrnl++;
+
+        if (j->op == JRNL_ERASE)
+        {
+            QSPI_Index_RemoveRange(&s_index, log_seg_addr(j->seg), j->n * QSPI_LOG_SEG_SIZE, LOG_HDR_SIZE);
+            for (uint32_t k = 0; k < j->n; k++)
+            {
+                memset(&s_seg[j->seg + k], 0, sizeof(s_seg[0]));
+                for (uint32_t i = 0; i < *norder; i++)
+                {
+                    if (order[i] == (j->seg + k))
+                        order[i] = UINT16_MAX;
+                }
+                if (s_open == (int32_t)(j->seg + k))
+                    s_open = -1;
+            }
+            continue;
+        }
+
+        /* OPEN / SPAN: content comes from the scan */
+        if ((j->op == JRNL_OPEN) && (s_open >= 0))
+            s_seg[s_open].state = SEG_USED;
+        if (j->op == JRNL_OPEN)
+            s_open = j->seg;
+        for (uint32_t k = 0; k < ((j->op == JRNL_SPAN) ? j->n : 1U); k++)
+            memset(&s_seg[j->seg + k], 0, sizeof(s_seg[0]));
+        order[(*norder)++] = j->seg;
+    }
+    return intact;
+}
+
+/* ---------------- allocation ---------------- */
+
+static inline uint32_t log_seg_wear(uint32_t seg)
+{
+#if QSPI_WEAR_ENABLE
+    return QSPI_Wear_Count(log_seg_addr(seg));
+#else
+    (void)seg;
+    return 0U;
+#endif
+}
+
+/* Least worn free segment */
+static int32_t log_pick_free(void)
+{
+    int32_t best = -1;
+    for (uint32_t i = 0; i < QSPI_LOG_SEGS; i++)
+    {
+        if ((s_seg[i].state == SEG_FREE) && !log_gc_opening(i) &&
+            ((best < 0) || (log_seg_wear(i) < log_seg_wear((uint32_t)best))))
+            best = (int32_t)i;
+    }
+    return best;
+}
+
+/* seg (verified blank, journaled) becomes the open segment */
+static void log_open_seg(uint32_t seg)
+{
+    if (s_open >= 0)
+        s_seg[s_open].state = SEG_USED;
+    s_open = (int32_t)seg;
+    memset(&s_seg[seg], 0, sizeof(s_seg[seg]));
+    s_seg[seg].state = SEG_OPEN;
+}
+
+/* Close the open segment and open a verified-blank one */
+static bool log_open_new(bool gc)
+{
+    for (;;)
+    {
+        if (log_free_count() <= (gc ? 0U : QSPI_LOG_GC_RESERVE))
+            return false;
+
+        int32_t seg = log_pick_free();
+        if (!log_blank(log_seg_addr((uint32_t)seg), QSPI_LOG_SEG_SIZE))
+        {
+            s_seg[seg].state = SEG_DIRTY;
+            continue;
+        }
+        if (!log_jrnl(JRNL_OPEN, (uint32_t)seg, 1U))
+            return false;
+
+        log_open_seg((uint32_t)seg);
+        return true;
+    }
+}
+
+/* n consecutive verified-blank free segments for a large record */
+static bool log_alloc_span(uint32_t n, bool gc, uint32_t *seg_out)
+{
+    if ((n > QSPI_LOG_SEGS) || (log_free_count() < (n + (gc ? 0U : QSPI_LOG_GC_RESERVE))))
+        return false;
+
+    for (uint32_t first = 0; (first + n) <= QSPI_LOG_SEGS; first++)
+    {
+        uint32_t k = 0U;
+        while ((k < n) && (s_seg[first + k].state == SEG_FREE) && !log_gc_opening(first + k))
+        {
+            if (!log_blank(log_seg_addr(first + k), QSPI_LOG_SEG_SIZE))
+            {
+                s_seg[first + k].state = SEG_DIRTY;
+                break;
+            }
+            k++;
+        }
+        if (k == n)
+        {
+            *seg_out = first;
+            return true;
+        }
+        first += k;
+    }
+    return false;
+}
+
+/* Reserve space for a record of rec bytes; gc = may use the GC reserve */
+static bool log_alloc(uint32_t rec, bool gc, uint32_t *addr_out)
+{
+    if (rec <= QSPI_LOG_SEG_SIZE)
+    {
+        if ((s_open < 0) || ((s_seg[s_open].used + rec) > QSPI_LOG_SEG_SIZE))
+        {
+            if (!log_open_new(gc))
+                return false;
+        }
+        *addr_out = log_seg_addr((uint32_t)s_open) + s_seg[s_open].used;
+        s_seg[s_open].used = (uint16_t)(s_seg[s_open].used + rec);
+        return true;
+    }
+
+    uint32_t n = (rec + QSPI_LOG_SEG_SIZE - 1U) / QSPI_LOG_SEG_SIZE;
+    uint32_t seg;
+    if (!log_alloc_span(n, gc, &seg) || !log_jrnl(JRNL_SPAN, seg, n))
+        return false;
+
+    s_seg[seg].state = SEG_SPAN;
+    s_seg[seg].span  = (uint8_t)n;
+    s_seg[seg].used  = (uint16_t)QSPI_LOG_SEG_SIZE;
+    for (uint32_t k = 1; k < n; k++)
+        s_seg[seg + k].state = SEG_CONT;
+    *addr_out = log_seg_addr(seg);
+    return true;
+}
+
+/* After a failed program nothing may follow the torn record: a walk stops there */
+static void log_seal_open(void)
+{
+    if (s_open >= 0)
+        s_seg[s_open].state = SEG_USED;
+    s_open = -1;
+}
+
+static void log_note_seq(uint32_t addr, uint32_t seq)
+{
+    log_seg_t *s = &s_seg[log_seg_of(addr)];
+    if ((s->seq_min == 0U) || (seq < s->seq_min))
+        s->seq_min = seq;
+    if (seq > s->seq_max)
+        s->seq_max = seq;
+}
+
+/* ---------------- programming ---------------- */
+
+static bool log_commit(uint32_t addr, const qspi_log_hdr_t *h)
+{
+    uint16_t flags = (uint16_t)(h->obj.flags & ~QSPI_LOG_FLAG_UNCOMMITTED);
+    const qspi_job_seg_t seg = { addr + LOG_FLAGS_OFF, &flags, (uint32_t)sizeof(flags) };
+    return log_job(0U, 0U, &seg, 1U);
+}
+
+/* Header (uncommitted) + payload from RAM, then commit */
+static bool log_write_rec(uint32_t addr, const qspi_log_hdr_t *h, const void *data)
+{
+    const qspi_job_seg_t segs[2] =
+    {
+        { addr,                h,    LOG_HDR_SIZE },
+        { addr + LOG_HDR_SIZE, data, h->obj.payload_len },
+    };
+
+    return log_job(0U, 0U, segs, (h->obj.payload_len != 0U) ? 2U : 1U) &&
+           log_commit(addr, h);
+}
+
+static bool log_append(uint32_t type_id, uint32_t version, uint16_t flags,
+                       const void *data, uint32_t len)
+{
+    qspi_log_hdr_t h;
+    uint32_t addr;
+    uint32_t rec = log_rec_size(len);
+
+    if (!s_mounted || ((len != 0U) && (data == NULL)) || (rec > (QSPI_LOG_SIZE / 2U)))
+        return false;
+    if ((QSPI_Index_Get(&s_index, type_id) == NULL) && !QSPI_Index_HasRoom(&s_index))
+    {
+        printf("[QSPI_LOG] index full (QSPI_LOG_INDEX_SLOTS), type %lu refused\r\n",
+               (unsigned long)type_id);
+        return false;
+    }
+
+    while (!log_alloc(rec, false, &addr))
+    {
+        if (!QSPI_Log_Gc())
+        {
+            printf("[QSPI_LOG] store full (%lu B record)\r\n", (unsigned long)rec);
+            return false;
+        }
+    }
+
+    memset(&h, 0xFF, sizeof(h));
+    h.obj.magic       = QSPI_LOG_MAGIC;
+    h.obj.header_len  = (uint16_t)LOG_HDR_SIZE;
+    h.obj.flags       = flags;
+    h.obj.type_id     = type_id;
+    h.obj.version     = version;
+    h.obj.payload_len = len;
+    h.obj.payload_crc = (len != 0U) ? QSPI_CRC_HW_Buffer(data, len) : 0U;
+    h.seq             = s_next_seq++;
+    h.obj.header_crc  = log_hdr_crc(&h);
+
+    log_note_seq(addr, h.seq);
+    if (!log_write_rec(addr, &h, data))
+    {
+        printf("[QSPI_LOG] append @0x%06lX failed\r\n", (unsigned long)addr);
+        log_seal_open();
+        return false;
+    }
+    (void)log_index_put(addr, &h);
+
+    s_stats.appends++;
+    s_stats.append_bytes += rec;
+    return true;
+}
+
+/* ---------------- GC ---------------- */
+
+/*
+ * Reclaim = move the current records out of a victim segment, then erase it.
+ * The copy runs as a state machine over async jobs, one page per job, so
+ * QSPI_Log_Task() can do it in bounded slices between the other superloop
+ * tasks; QSPI_Log_Gc() drives the same machine to completion when an append
+ * is short of space. The segment a copy moves into is opened by the machine
+ * too (blank check one chunk per step, journal entry as a job), and so is
+ * the erase journal entry. Only a checkpoint, when the journal is full, is
+ * written blocking: the background does it in a call of its own
+ * (s_gc.ckpt).
+ *
+ * Copy protocol per record: header (uncommitted) -> payload (CRC checked on
+ * the way) -> commit; the index moves to the copy only if it still names the
+ * source, so a foreground write of the same type in between wins. A reset
+ * mid-copy leaves an uncommitted record, i.e. stale bytes.
+ */
+typedef enum
+{
+    GC_IDLE = 0,
+    GC_NEXT,                /* look at the record at off */
+    GC_COPY,                /* header out, payload chunks */
+    GC_COMMIT,              /* commit programmed, move the index */
+    GC_OPEN,                /* blank check of the segment to copy into */
+    GC_OPEN_JRNL,           /* its journal entry in flight, opened by the callback */
+    GC_ERASE,               /* victim empty: journal the erase */
+    GC_ERASE_JRNL,          /* journal entry in flight, then the erase */
+    GC_DONE,                /* erase in flight, finished by its callback */
+} log_gc_state_t;
+
+typedef struct
+{
+    uint8_t  state;
+    bool     wear;          /* cold-data move, not a stale reclaim */
+    volatile bool job_pending;
+    volatile bool job_ok;
+    bool     last_ok;       /* result of the last finished pass */
+    bool     ckpt;          /* stalled: the journal needs a checkpoint first */
+    uint32_t victim;
+    uint32_t nsegs;
+    uint32_t off;           /* next record in the victim */
+    uint32_t src;
+    uint32_t dst;
+    uint32_t done;          /* payload bytes copied */
+    uint32_t crc;
+    uint16_t flags;         /* commit halfword */
+    uint32_t seg;           /* GC_OPEN*: segment being opened */
+    uint32_t checked;       /* bytes of it verified blank */
+    log_jrnl_t jrnl;        /* entry in flight */
+    qspi_log_hdr_t hdr;     /* copy of the source header, uncommitted */
+} log_gc_t;
+
+static log_gc_t s_gc;
+static uint32_t s_gc_t0;
+
+__attribute__((aligned(4)))
+static uint8_t  s_gc_buf[LOG_COPY_CHUNK];
+
+static void log_gc_done(bool ok)
+{
+    /* the blank check may have skipped the erase, so no NoteErase */
+    for (uint32_t k = 0; k < s_gc.nsegs; k++)
+    {
+        memset(&s_seg[s_gc.victim + k], 0, sizeof(s_seg[0]));
+        s_live[s_gc.victim + k] = 0U;
+        if (!ok)
+            s_seg[s_gc.victim + k].state = SEG_DIRTY;
+    }
+    if (ok)
+    {
+        s_stats.gc_erases += s_gc.nsegs;
+        if (s_gc.wear)
+            s_stats.gc_wear++;
+    }
+    else
+    {
+        printf("[QSPI_LOG] GC: erase of segment %lu failed\r\n", (unsigned long)s_gc.victim);
+    }
+    s_gc.state   = GC_IDLE;
+    s_gc.last_ok = ok;
+}
+
+static void log_gc_job_done(bool ok, void *ctx)
+{
+    (void)ctx;
+
+    /* a failed copy may be a torn header: seal before anything is appended
+     * behind it (a foreground append waits for this job) */
+    if (!ok && ((s_gc.state == GC_COPY) || (s_gc.state == GC_COMMIT)) &&
+        (s_open == (int32_t)log_seg_of(s_gc.dst)))
+        log_seal_open();
+    s_gc.job_ok = ok;
+    s_gc.job_pending = false;
+
+    /* in journal order: an append waiting for this job opens its own after */
+    if (ok && (s_gc.state == GC_OPEN_JRNL))
+        log_open_seg(s_gc.seg);
+
+    /* the segments are free from now on: an append may take them before
+     * the next QSPI_Log_Task */
+    if (s_gc.state == GC_DONE)
+        log_gc_done(ok);
+}
+
+static bool log_gc_job(uint32_t erase_addr, uint32_t erase_len, const qspi_job_seg_t *seg)
+{
+    s_gc.job_ok = false;
+    s_gc.job_pending = true;
+    if (!QSPI_Job_Write(erase_addr, erase_len, seg, (seg != NULL) ? 1U : 0U, (seg != NULL),
+                        log_gc_job_done, NULL))
+    {
+        s_gc.job_pending = false;
+        return false;
+    }
+    return true;
+}
+
+static void log_gc_start(uint32_t victim, uint32_t nsegs, bool wear, log_gc_state_t state)
+{
+    memset(&s_gc, 0, sizeof(s_gc));
+    s_gc.state  = (uint8_t)state;
+    s_gc.victim = victim;
+    s_gc.nsegs  = nsegs;
+    s_gc.wear   = wear;
+}
+
+/* Give up on the victim; it stays as it is, records and index untouched */
+static bool log_gc_abort(const char *why)
+{
+    printf("[QSPI_LOG] GC of segment %lu aborted: %s\r\n", (unsigned long)s_gc.victim, why);
+    if (((s_gc.state == GC_COPY) || (s_gc.state == GC_COMMIT)) &&
+        (s_open == (int32_t)log_seg_of(s_gc.dst)))
+        log_seal_open();
+    s_gc.state   = GC_IDLE;
+    s_gc.last_ok = false;
+    s_gc.ckpt    = false;
+    return false;
+}
+
+/* Free segment GC has picked to open: kept from the allocator meanwhile */
+static bool log_gc_opening(uint32_t seg)
+{
+    return ((s_gc.state == GC_OPEN) || (s_gc.state == GC_OPEN_JRNL)) && (s_gc.seg == seg);
+}
+
+/* Program a journal entry as an async job, then go to state next. A full
+ * journal stalls the pass (s_gc.ckpt) until a checkpoint is written. */
+static bool log_gc_jrnl(log_jrnl_op_t op, uint32_t seg, uint32_t n, log_gc_state_t next)
+{
+    if (log_jrnl_full())
+    {
+        s_gc.ckpt = true;
+        return false;
+    }
+
+    const qspi_job_seg_t jseg =
+        { log_jrnl_entry(&s_gc.jrnl, op, seg, n), &s_gc.jrnl, (uint32_t)sizeof(s_gc.jrnl) };
+    s_gc.state = (uint8_t)next;
+    if (log_gc_job(0U, 0U, &jseg))
+        return true;
+    s_jrnl_next--;                  /* nothing programmed, the slot is still blank */
+    return log_gc_abort("journal");
+}
+
+/* The copy does not fit the open segment: pick the next one to open */
+static bool log_gc_open(void)
+{
+    int32_t seg = (log_free_count() != 0U) ? log_pick_free() : -1;
+
+    if (seg < 0)
+        return log_gc_abort("no free segment");
+    s_gc.seg     = (uint32_t)seg;
+    s_gc.checked = 0U;
+    s_gc.state   = GC_OPEN;
+    return true;
+}
+
+/* One chunk of the blank check per step, then the journal entry */
+static bool log_gc_open_check(void)
+{
+    if (s_gc.checked < QSPI_LOG_SEG_SIZE)
+    {
+        if (!log_blank(log_seg_addr(s_gc.seg) + s_gc.checked, LOG_COPY_CHUNK))
+        {
+            s_seg[s_gc.seg].state = SEG_DIRTY;
+            return log_gc_open();
+        }
+        s_gc.checked += LOG_COPY_CHUNK;
+        return true;
+    }
+    return log_gc_jrnl(JRNL_OPEN, s_gc.seg, 1U, GC_OPEN_JRNL);
+}
+
+typedef struct
+{
+    uint32_t live;
+    uint32_t stale;
+} log_usage_t;
+
+static bool log_usage_visit(uint32_t addr, const qspi_log_hdr_t *h, void *ctx)
+{
+    log_usage_t *u = (log_usage_t *)ctx;
+    if (log_rec_live(addr, h))
+        u->live++;
+    else
+        u->stale++;
+    return true;
+}
+
+/*
+ * Choose what to reclaim next; false = nothing worth it.
+ *   1) DIRTY segments, large records that are no longer current: erase only
+ *   2) the closed segment with the best score
+ *        stale bytes (per mille of the segment)
+ *        - QSPI_LOG_GC_WEAR_COST per erase above the least worn segment,
+ *      in the background only above QSPI_LOG_GC_MIN_STALE unless free
+ *      segments are down to QSPI_LOG_GC_FREE_LOW
+ *   3) background: cold data sitting on a segment QSPI_LOG_GC_WEAR_DELTA
+ *      erases behind the most worn one is moved, so its segment rejoins the
+ *      (least worn first) free pool
+ *   4) forced: oldest segment holding delete markers that are no longer needed
+ */
+static bool log_gc_pick(bool forced)
+{
+    uint32_t wmin = UINT32_MAX, wmax = 0U;
+    int32_t best = -1, cold = -1;
+    int32_t best_score = INT32_MIN;
+
+    for (uint32_t i = 0; i < QSPI_LOG_SEGS; i++)
+    {
+        if (s_seg[i].state == SEG_DIRTY)
+        {
+            log_gc_start(i, 1U, false, GC_ERASE);
+            return true;
+        }
+        if ((s_seg[i].state == SEG_SPAN) && (s_live[i] == 0U))
+        {
+            log_gc_start(i, s_seg[i].span, false, GC_ERASE);
+            return true;
+        }
+        uint32_t w = log_seg_wear(i);
+        if (w < wmin)
+            wmin = w;
+        if (w > wmax)
+            wmax = w;
+    }
+
+    for (uint32_t i = 0; i < QSPI_LOG_SEGS; i++)
+    {
+        if (s_seg[i].state != SEG_USED)
+            continue;
+
+        uint32_t w = log_seg_wear(i);
+        uint32_t stale = s_seg[i].used - s_live[i];
+        if (stale == 0U)
+        {
+            if ((w + QSPI_LOG_GC_WEAR_DELTA < wmax) && ((cold < 0) || (w < log_seg_wear((uint32_t)cold))))
+                cold = (int32_t)i;
+            continue;
+        }
+
+        int32_t score = (int32_t)((stale * 1000U) / QSPI_LOG_SEG_SIZE) -
+                        (int32_t)(QSPI_LOG_GC_WEAR_COST * (w - wmin));
+        if (score > best_score)
+        {
+            best = (int32_t)i;
+            best_score = score;
+        }
+    }
+
+    if ((best >= 0) &&
+        (forced || (best_score >= (int32_t)QSPI_LOG_GC_MIN_STALE) ||
+         (log_free_count() <= QSPI_LOG_GC_FREE_LOW)))
+    {
+        log_gc_start((uint32_t)best, 1U, false, GC_NEXT);
+        return true;
+    }
+
+    if (!forced)
+    {
+        /* a move needs room for a whole segment of live records */
+        if ((cold < 0) || (log_free_count() <= (QSPI_LOG_GC_RESERVE + 1U)))
+            return false;
+        log_gc_start((uint32_t)cold, 1U, true, GC_NEXT);
+        return true;
+    }
+
+    uint32_t done_below = 0U;
+    for (;;)
+    {
+        int32_t victim = -1;
+        for (uint32_t i = 0; i < QSPI_LOG_SEGS; i++)
+        {
+            if ((s_seg[i].state == SEG_USED) && (s_seg[i].seq_max >= done_below) &&
+                ((victim < 0) || (s_seg[i].seq_max < s_seg[victim].seq_max)))
+                victim = (int32_t)i;
+        }
+        if (victim < 0)
+            return false;
+        done_below = s_seg[victim].seq_max + 1U;
+
+        log_usage_t u = { 0U, 0U };
+        (void)log_walk_seg((uint32_t)victim, log_usage_visit, &u);
+        if ((u.stale != 0U) || (s_seg[victim].used == 0U))
+        {
+            log_gc_start((uint32_t)victim, 1U, false, GC_NEXT);
+            return true;
+        }
+    }
+}
+
+/* Next record of the victim: skip, drop or start its copy */
+static bool log_gc_next(void)
+{
+    const uint32_t base = log_seg_addr(s_gc.victim);
+    qspi_log_hdr_t h;
+
+    if ((s_gc.off >= s_seg[s_gc.victim].used) ||
+        !log_read_hdr(base + s_gc.off, &h) || !log_hdr_valid(&h))
+    {
+        s_gc.state = GC_ERASE;          /* done, or torn tail: nothing valid behind it */
+        return true;
+    }
+
+    const uint32_t rec = log_rec_size(h.obj.payload_len);
+    s_gc.src  = base + s_gc.off;
+    s_gc.off += rec;
+
+    if (log_indexed(s_gc.src, &h) == NULL)
+        return true;                    /* superseded */
+    if (!log_rec_live(s_gc.src, &h))
+    {
+        log_index_drop(h.obj.type_id);  /* delete marker not needed */
+        return true;
+    }
+    if ((s_open < 0) || ((s_seg[s_open].used + rec) > QSPI_LOG_SEG_SIZE))
+    {
+        s_gc.off -= rec;                /* looked at again once it is open */
+        return log_gc_open();
+    }
+    if (!log_alloc(rec, true, &s_gc.dst))
+        return log_gc_abort("no free segment");
+
+    log_note_seq(s_gc.dst, h.seq);
+    s_gc.hdr = h;
+    s_gc.hdr.obj.flags |= QSPI_LOG_FLAG_UNCOMMITTED;
+    s_gc.done = 0U;
+    s_gc.crc  = 0U;
+    s_gc.state = GC_COPY;
+
+    const qspi_job_seg_t seg = { s_gc.dst, &s_gc.hdr, LOG_HDR_SIZE };
+    return log_gc_job(0U, 0U, &seg) || log_gc_abort("header program");
+}
+
+/* The source is still the current record of its type */
+static bool log_gc_src_current(void)
+{
+    const qspi_index_entry_t *e = QSPI_Index_Get(&s_index, s_gc.hdr.obj.type_id);
+    return (e != NULL) && (e->address == s_gc.src) && (e->seq == s_gc.hdr.seq);
+}
+
+static bool log_gc_copy(void)
+{
+    const uint32_t len = s_gc.hdr.obj.payload_len;
+
+    if (s_gc.done < len)
+    {
+        uint32_t n = len - s_gc.done;
+        if (n > LOG_COPY_CHUNK)
+            n = LOG_COPY_CHUNK;
+
+        if (!QSPI_Flash_ReadData(s_gc.src + LOG_HDR_SIZE + s_gc.done, s_gc_buf, n, NULL))
+            return log_gc_abort("source read");
+        s_gc.crc = QSPI_CRC32_Update(s_gc.crc, s_gc_buf, n);
+
+        const qspi_job_seg_t seg = { s_gc.dst + LOG_HDR_SIZE + s_gc.done, s_gc_buf, n };
+        s_gc.done += n;
+        return log_gc_job(0U, 0U, &seg) || log_gc_abort("payload program");
+    }
+
+    if (s_gc.crc != s_gc.hdr.obj.payload_crc)
+    {
+        printf("[QSPI_LOG] GC: type %lu seq %lu corrupt, dropped\r\n",
+               (unsigned long)s_gc.hdr.obj.type_id, (unsigned long)s_gc.hdr.seq);
+        if (log_gc_src_current())
+            log_index_drop(s_gc.hdr.obj.type_id);
+        s_gc.state = GC_NEXT;           /* the copy stays uncommitted */
+        return true;
+    }
+    if (!log_gc_src_current())
+    {
+        s_gc.state = GC_NEXT;           /* rewritten meanwhile: leave the copy uncommitted */
+        return true;
+    }
+
+    s_gc.flags = (uint16_t)(s_gc.hdr.obj.flags & ~QSPI_LOG_FLAG_UNCOMMITTED);
+    s_gc.state = GC_COMMIT;
+
+    const qspi_job_seg_t seg = { s_gc.dst + LOG_FLAGS_OFF, &s_gc.flags, (uint32_t)sizeof(s_gc.flags) };
+    return log_gc_job(0U, 0U, &seg) || log_gc_abort("commit");
+}
+
+static bool log_gc_erase(void)
+{
+    s_gc.state = GC_DONE;
+    return log_gc_job(log_seg_addr(s_gc.victim), s_gc.nsegs * QSPI_LOG_SEG_SIZE, NULL) ||
+           log_gc_abort("erase");
+}
+
+/* One step; false = waiting for a job, or the pass is over */
+static bool log_gc_step(void)
+{
+    if (s_gc.job_pending || QSPI_Job_IsBusy())
+        return false;
+
+    switch (s_gc.state)
+    {
+    case GC_NEXT:
+        return log_gc_next();
+
+    case GC_COPY:
+        if (!s_gc.job_ok)
+            return log_gc_abort("program");
+        return log_gc_copy();
+
+    case GC_COMMIT:
+        if (!s_gc.job_ok)
+            return log_gc_abort("commit");
+        if (log_gc_src_current())
+        {
+            qspi_log_hdr_t h = s_gc.hdr;
+            h.obj.flags = s_gc.flags;
+            (void)log_index_put(s_gc.dst, &h);
+            s_stats.gc_moved++;
+        }
+        s_gc.state = GC_NEXT;
+        return true;
+
+    case GC_OPEN:
+        return log_gc_open_check();
+
+    case GC_OPEN_JRNL:
+        if (!s_gc.job_ok)
+            return log_gc_abort("journal");
+        s_gc.state = GC_NEXT;           /* opened by the callback */
+        return true;
+
+    case GC_ERASE:
+        return log_gc_jrnl(JRNL_ERASE, s_gc.victim, s_gc.nsegs, GC_ERASE_JRNL);
+
+    case GC_ERASE_JRNL:
+        if (!s_gc.job_ok)
+            return log_gc_abort("journal");
+        return log_gc_erase();
+
+    default:
+        return false;
+    }
+}
+
+/* Checkpoint a stalled pass is waiting for (blocking) */
+static void log_gc_ckpt(void)
+{
+    s_gc.ckpt = false;
+    if (log_jrnl_full() && !log_ckpt_write())
+        (void)log_gc_abort("checkpoint");
+}
+
+/* Drive the current pass to the end (blocking) */
+static bool log_gc_run(void)
+{
+    while (s_gc.state != GC_IDLE)
+    {
+        if (s_gc.job_pending || QSPI_Job_IsBusy())
+            (void)QSPI_Job_Wait();
+        if (!log_gc_step() && s_gc.ckpt)
+            log_gc_ckpt();
+    }
+    return s_gc.last_ok;
+}
+
+/* A checkpoint must not fall between a copy's header and its index update:
+ * the record lies below the checkpointed fill level, so mount would not
+ * read it again. Nor between an erase's journal entry and the erase, which
+ * the new journal would not record. */
+static void log_gc_settle(void)
+{
+    while ((s_gc.state == GC_COPY) || (s_gc.state == GC_COMMIT) || (s_gc.state == GC_ERASE_JRNL))
+    {
+        if (s_gc.job_pending || QSPI_Job_IsBusy())
+            (void)QSPI_Job_Wait();
+        (void)log_gc_step();
+    }
+}
+
+static void log_ckpt_spare_done(bool ok, void *ctx)
+{
+    s_ckpt_blank = ok ? (int32_t)(uintptr_t)ctx : -1;
+    s_ckpt_spare_busy = false;
+}
+
+/* Erase the next checkpoint area ahead of time once the journal is half
+ * full, so the checkpoint write that follows is programs only */
+static bool log_ckpt_spare_prepare(void)
+{
+    if ((s_ckpt_area < 0) || s_ckpt_spare_busy || (s_jrnl_next < (LOG_JRNL_ENTRIES / 2U)))
+        return false;
+
+    const uint32_t area = (s_ckpt_area == 0) ? 1U : 0U;
+    if (s_ckpt_blank == (int32_t)area)
+        return false;
+
+    s_ckpt_spare_busy = true;
+    if (!QSPI_Job_Write(log_ckpt_addr(area), QSPI_LOG_CKPT_SIZE, NULL, 0U, false,
+                        log_ckpt_spare_done, (void *)(uintptr_t)area))
+    {
+        s_ckpt_spare_busy = false;
+        return false;
+    }
+    return true;
+}
+
+bool QSPI_Log_Gc(void)
+{
+    if (!s_mounted)
+        return false;
+
+    s_stats.gc_runs++;
+
+    /* a background pass in progress is finished first, it frees space too */
+    if ((s_gc.state != GC_IDLE) && log_gc_run())
+        return true;
+    return log_gc_pick(true) && log_gc_run();
+}
+
+void QSPI_Log_Task(void)
+{
+    if (!s_mounted || s_gc.job_pending || QSPI_Job_IsBusy())
+        return;
+
+    const uint32_t t0 = DWT->CYCCNT;
+    if (s_gc.ckpt)
+    {
+        /* spare area erased in the background first, so the checkpoint
+         * is only programs; it gets this call to itself */
+        if (!log_ckpt_spare_prepare())
+            log_gc_ckpt();
+    }
+    else
+    {
+        if (s_gc.state == GC_IDLE)
+        {
+            if ((millis() - s_gc_t0) < QSPI_LOG_GC_PERIOD_MS)
+                return;
+            s_gc_t0 = millis();
+
+            if (log_ckpt_spare_prepare() || !log_gc_pick(false))
+                return;
+            s_stats.gc_bg++;
+        }
+
+        /* each step starts at most one job and the next one finds it busy */
+        while (log_gc_step() &&
+               ((DWT->CYCCNT - t0) < (QSPI_LOG_GC_SLICE_US * (uint32_t)(CPU_CLOCK_HZ / 1000000UL))))
+        {
+        }
+    }
+
+    uint32_t us = (DWT->CYCCNT - t0) / (uint32_t)(CPU_CLOCK_HZ / 1000000UL);
+    if (us > s_stats.gc_slice_max_us)
+        s_stats.gc_slice_max_us = us;
+}
+
+/* ---------------- mount / API ---------------- */
+
+static void log_index_scan(uint32_t addr, const qspi_log_hdr_t *h)
+{
+    const qspi_index_entry_t *e = QSPI_Index_Get(&s_index, h->obj.type_id);
+
+    /* >=: a GC copy keeps the sequence number of its original */
+    if (log_committed(h) && ((e == NULL) || (h->seq >= e->seq)))
+        (void)log_index_put(addr, h);
+}
+
+/*
+ * Scan the records of seg from off on: segment state, sequence numbers,
+ * index. Returns true if the segment ends in a torn header (sealed: no
+ * appends behind it).
+ */
+static bool log_scan_seg(uint32_t seg, uint32_t off)
+{
+    log_seg_t *s = &s_seg[seg];
+    bool sealed = false;
+
+    while ((off + LOG_HDR_SIZE) <= QSPI_LOG_SEG_SIZE)
+    {
+        qspi_log_hdr_t h;
+        if (!log_read_hdr(log_seg_addr(seg) + off, &h))
+        {
+            sealed = true;
+            break;
+        }
+        if (h.obj.magic == LOG_ERASED_WORD)
+            break;
+        if (!log_hdr_valid(&h))
+        {
+            sealed = true;      /* torn header: nothing usable behind it */
+            break;
+        }
+        s_stats.mount_records++;
+
+        uint32_t rec = log_rec_size(h.obj.payload_len);
+        if (h.seq >= s_next_seq)
+            s_next_seq = h.seq + 1U;
+        if ((s->seq_min == 0U) || (h.seq < s->seq_min))
+            s->seq_min = h.seq;
+        if (h.seq > s->seq_max)
+            s->seq_max = h.seq;
+
+        if ((off + rec) > QSPI_LOG_SEG_SIZE)
+        {
+            uint32_t n = (rec + QSPI_LOG_SEG_SIZE - 1U) / QSPI_LOG_SEG_SIZE;
+            if ((off != 0U) || ((seg + n) > QSPI_LOG_SEGS))
+            {
+                sealed = true;
+                break;
+            }
+            log_index_scan(log_seg_addr(seg), &h);
+            s->state = SEG_SPAN;
+            s->span  = (uint8_t)n;
+            s->used  = (uint16_t)QSPI_LOG_SEG_SIZE;
+            for (uint32_t k = 1; k < n; k++)
+                s_seg[seg + k].state = SEG_CONT;
+            return false;
+        }
+        log_index_scan(log_seg_addr(seg) + off, &h);
+        off += rec;
+    }
+
+    s->used  = (uint16_t)off;
+    s->state = (off != 0U) ? SEG_USED : (sealed ? SEG_DIRTY : SEG_FREE);
+    return sealed;
+}
+
+bool QSPI_Log_Mount(void)
+{
+    const qspi_flash_ops_t *ops = QSPI_Flash_Ops();
+    static uint16_t order[LOG_JRNL_ENTRIES + 1U];
+    uint32_t norder = 0U;
+    int32_t newest = -1;
+    bool newest_sealed = false;
+    bool need_ckpt;
+    uint32_t t0 = DWT->CYCCNT;
+
+    s_mounted = false;
+    s_open = -1;
+    s_ckpt_area = -1;
+    s_ckpt_gen = 0U;
+    s_jrnl_next = 0U;
+    s_ckpt_blank = -1;
+    memset(&s_gc, 0, sizeof(s_gc));
+    memset(s_seg, 0, sizeof(s_seg));
+    memset(s_live, 0, sizeof(s_live));
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_next_seq = 1U;
+    QSPI_Index_Init(&s_index, s_index_slots, QSPI_LOG_INDEX_SLOTS);
+
+    if ((ops == NULL) || ((QSPI_LOG_BASE + QSPI_LOG_SIZE) > ops->capacity) ||
+        ((QSPI_LOG_SEG_SIZE % ops->sector_size) != 0U) ||
+        ((QSPI_LOG_CKPT_SIZE % ops->sector_size) != 0U))
+    {
+        printf("[QSPI_LOG] region does not fit this flash\r\n");
+        return false;
+    }
+#if QSPI_WEAR_ENABLE
+    if (QSPI_Wear_Overlaps(QSPI_LOG_BASE, QSPI_LOG_SIZE))
+    {
+        printf("[QSPI_LOG] region overlaps the wear counters\r\n");
+        return false;
+    }
+#endif
+
+    if (log_ckpt_load())
+    {
+        /* checkpoint + journal: scan only what was opened since */
+        need_ckpt = !log_jrnl_replay(order, &norder);
+        s_open = -1;
+        for (uint32_t i = 0; i < norder; i++)
+        {
+            if (order[i] == UINT16_MAX)
+                continue;
+            bool sealed = log_scan_seg(order[i], s_seg[order[i]].used);
+            if (s_seg[order[i]].state == SEG_USED)
+            {
+                newest = (int32_t)order[i];
+                newest_sealed = sealed;
+            }
+        }
+    }
+    else
+    {
+        /* no checkpoint: every header */
+        s_stats.mount_full = 1U;
+        need_ckpt = true;
+        for (uint32_t seg = 0; seg < QSPI_LOG_SEGS; seg++)
+        {
+            if (s_seg[seg].state == SEG_CONT)
+                continue;
+            bool sealed = log_scan_seg(seg, 0U);
+            if ((s_seg[seg].state == SEG_USED) &&
+                ((newest < 0) || (s_seg[seg].seq_max > s_seg[newest].seq_max)))
+            {
+                newest = (int32_t)seg;
+                newest_sealed = sealed;
+            }
+        }
+    }
+
+    if (s_index.dropped != 0U)
+    {
+        printf("[QSPI_LOG] more types than QSPI_LOG_INDEX_SLOTS allows, not mounted\r\n");
+        return false;
+    }
+    log_live_rebuild();
+
+    /* keep appending into the newest segment if its tail is still erased */
+    if ((newest >= 0) && !newest_sealed && (s_seg[newest].used < QSPI_LOG_SEG_SIZE) &&
+        log_blank(log_seg_addr((uint32_t)newest) + s_seg[newest].used,
+                  QSPI_LOG_SEG_SIZE - s_seg[newest].used))
+    {
+        s_open = newest;
+        s_seg[newest].state = SEG_OPEN;
+    }
+
+    s_mounted = true;
+    s_stats.mount_us = (DWT->CYCCNT - t0) / (uint32_t)(CPU_CLOCK_HZ / 1000000UL);
+
+    /* next boot starts from here instead of the full scan / torn journal */
+    if (need_ckpt && !log_ckpt_write())
+        printf("[QSPI_LOG] checkpoint write failed\r\n");
+
+    if (s_stats.mount_full != 0U)
+        printf("[QSPI_LOG] mounted in %lu us (full scan, %lu records): %lu types\r\n",
+               (unsigned long)s_stats.mount_us, (unsigned long)s_stats.mount_records,
+               (unsigned long)s_index.count);
+    else
+        printf("[QSPI_LOG] mounted in %lu us (checkpoint %lu + %lu journal, %lu records): %lu types\r\n",
+               (unsigned long)s_stats.mount_us, (unsigned long)s_ckpt_gen,
+               (unsigned long)s_stats.mount_jrnl, (unsigned long)s_stats.mount_records,
+               (unsigned long)s_index.count);
+    return true;
+}
+
+bool QSPI_Log_Format(void)
+{
+    if (QSPI_Flash_Ops() == NULL)
+        return false;
+    if (!log_job(QSPI_LOG_BASE, QSPI_LOG_SIZE, NULL, 0U))
+        return false;
+
+    memset(s_seg, 0, sizeof(s_seg));
+    memset(s_live, 0, sizeof(s_live));
+    memset(&s_gc, 0, sizeof(s_gc));
+    QSPI_Index_Init(&s_index, s_index_slots, QSPI_LOG_INDEX_SLOTS);
+    s_open = -1;
+    s_ckpt_area = -1;
+    s_ckpt_blank = -1;
+    s_mounted = true;
+    return log_ckpt_write();
+}
+
+bool QSPI_Log_Checkpoint(void)
+{
+    return s_mounted && log_ckpt_write();
+}
+
+bool QSPI_Log_Write(uint32_t type_id, uint32_t version, const void *data, uint32_t len)
+{
+    return log_append(type_id, version, 0xFFFFU, data, len);
+}
+
+bool QSPI_Log_Delete(uint32_t type_id)
+{
+    const qspi_index_entry_t *e = s_mounted ? QSPI_Index_Get(&s_index, type_id) : NULL;
+
+    if ((e == NULL) || ((e->flags & QSPI_INDEX_F_DELETED) != 0U))
+        return false;
+    return log_append(type_id, e->version,
+                      (uint16_t)(0xFFFFU & ~QSPI_LOG_FLAG_DATA), NULL, 0U);
+}
+
+bool QSPI_Log_Read(uint32_t type_id, void *buf, uint32_t max_len,
+                   uint32_t *len_out, uint32_t *version_out)
+{
+    const qspi_index_entry_t *e = s_mounted ? QSPI_Index_Get(&s_index, type_id) : NULL;
+    qspi_log_hdr_t h;
+    uint32_t crc;
+
+    if ((buf == NULL) || (e == NULL) || ((e->flags & QSPI_INDEX_F_DELETED) != 0U) ||
+        (e->len > max_len))
+        return false;
+
+    /* the header still carries the payload CRC; re-check it, then the payload */
+    const uint32_t addr = e->address;
+    if (!log_read_hdr(addr, &h) || !log_hdr_valid(&h) || (h.seq != e->seq))
+        return false;
+    if ((h.obj.payload_len != 0U) &&
+        (!QSPI_Flash_ReadData(addr + LOG_HDR_SIZE, buf, h.obj.payload_len, &crc) ||
+         (crc != h.obj.payload_crc)))
+        return false;
+
+    if (len_out != NULL)
+        *len_out = h.obj.payload_len;
+    if (version_out != NULL)
+        *version_out = h.obj.version;
+    return true;
+}
+
+bool QSPI_Log_ReadStream(uint32_t type_id, void *buf, uint32_t buf_len,
+                         qspi_flash_chunk_cb_t cb, void *ctx,
+                         uint32_t *len_out, uint32_t *version_out)
+{
+    const qspi_index_entry_t *e = s_mounted ? QSPI_Index_Get(&s_index, type_id) : NULL;
+    qspi_log_hdr_t h;
+    uint32_t crc = 0U;
+
+    if ((e == NULL) || ((e->flags & QSPI_INDEX_F_DELETED) != 0U))
+        return false;
+
+    const uint32_t addr = e->address;
+    if (!log_read_hdr(addr, &h) || !log_hdr_valid(&h) || (h.seq != e->seq))
+        return false;
+    if ((h.obj.payload_len != 0U) &&
+        (!QSPI_Flash_ReadDataStream(addr + LOG_HDR_SIZE, h.obj.payload_len, buf, buf_len,
+                                    cb, ctx, &crc) ||
+         (crc != h.obj.payload_crc)))
+        return false;
+
+    if (len_out != NULL)
+        *len_out = h.obj.payload_len;
+    if (version_out != NULL)
+        *version_out = h.obj.version;
+    return true;
+}
+
+void QSPI_Log_NoteErase(uint32_t addr, uint32_t len)
+{
+    if (!s_mounted || !QSPI_Log_Overlaps(addr, len))
+        return;
+
+    /* the current checkpoint went with it (chip erase): the next journal
+     * entry starts a new one */
+    if ((s_ckpt_area >= 0) && (addr < (log_ckpt_addr((uint32_t)s_ckpt_area) + QSPI_LOG_CKPT_SIZE)) &&
+        (log_ckpt_addr((uint32_t)s_ckpt_area) < (addr + len)))
+        s_ckpt_area = -1;
+
+    uint32_t lo = (addr > QSPI_LOG_DATA_BASE) ? addr : QSPI_LOG_DATA_BASE;
+    uint32_t hi = addr + len;
+    if (hi > (QSPI_LOG_BASE + QSPI_LOG_SIZE))
+        hi = QSPI_LOG_BASE + QSPI_LOG_SIZE;
+    if (hi <= lo)
+        return;
+
+    /* a chip erase under a GC pass took its victim (its own erase is GC_DONE) */
+    if ((s_gc.state != GC_IDLE) && (s_gc.state != GC_DONE))
+    {
+        s_gc.state = GC_IDLE;
+        s_gc.last_ok = false;
+        s_gc.ckpt = false;
+    }
+
+    QSPI_Index_RemoveRange(&s_index, lo, hi - lo, LOG_HDR_SIZE);
+    for (uint32_t seg = log_seg_of(lo); seg < log_seg_of(hi + QSPI_LOG_SEG_SIZE - 1U); seg++)
+    {
+        memset(&s_seg[seg], 0, sizeof(s_seg[seg]));
+        s_live[seg] = 0U;
+        if (s_open == (int32_t)seg)
+            s_open = -1;
+    }
+}
+
+bool QSPI_Log_Overlaps(uint32_t addr, uint32_t len)
+{
+    return (len != 0U) && (addr < (QSPI_LOG_BASE + QSPI_LOG_SIZE)) && (QSPI_LOG_BASE < (addr + len));
+}
+
+static bool log_count_visit(uint32_t addr, const qspi_log_hdr_t *h, void *ctx)
+{
+    (void)addr;
+    if (log_committed(h))
+        (*(uint32_t *)ctx)++;
+    return true;
+}
+
+void QSPI_Log_GetStats(qspi_log_stats_t *out)
+{
+    if (out == NULL)
+        return;
+
+    *out = s_stats;
+    out->segs_free = 0U;
+    out->segs_used = 0U;
+    out->segs_dirty = 0U;
+    for (uint32_t i = 0; i < QSPI_LOG_SEGS; i++)
+    {
+        if (s_seg[i].state == SEG_FREE)
+            out->segs_free++;
+        else if (s_seg[i].state == SEG_DIRTY)
+            out->segs_dirty++;
+        else
+            out->segs_used++;
+    }
+    out->records = 0U;
+    if (s_mounted)
+        log_walk(log_count_visit, &out->records);
+    out->types = s_index.count;
+    out->next_seq = s_next_seq;
+}
+
+void QSPI_Log_Print(void)
+{
+    qspi_log_stats_t st;
+
+    printf("---- Log store ----\r\n");
+    if (!s_mounted)
+    {
+        printf("  State         : NOT MOUNTED\r\n");
+        return;
+    }
+
+    QSPI_Log_GetStats(&st);
+    printf("  Region        : 0x%06lX..0x%06lX, 2 checkpoint areas + %lu segments\r\n",
+           (unsigned long)QSPI_LOG_BASE,
+           (unsigned long)(QSPI_LOG_BASE + QSPI_LOG_SIZE - 1UL),
+           (unsigned long)QSPI_LOG_SEGS);
+    printf("  Segments      : %lu free, %lu used, %lu dirty, open %ld @%u\r\n",
+           (unsigned long)st.segs_free, (unsigned long)st.segs_used,
+           (unsigned long)st.segs_dirty, (long)s_open,
+           (s_open >= 0) ? (unsigned)s_seg[s_open].used : 0U);
+    printf("  Records       : %lu committed, %lu types indexed (max probe %lu), next seq %lu\r\n",
+           (unsigned long)st.records, (unsigned long)st.types,
+           (unsigned long)s_index.probes_max, (unsigned long)st.next_seq);
+    printf("  Mount         : %lu us, %s, %lu journal, %lu records scanned, %lu types\r\n",
+           (unsigned long)st.mount_us,
+           (st.mount_full != 0U) ? "full scan" : "checkpoint",
+           (unsigned long)st.mount_jrnl, (unsigned long)st.mount_records,
+           (unsigned long)st.types);
+    printf("  Checkpoint    : gen %lu, journal %lu/%lu, %lu written\r\n",
+           (unsigned long)s_ckpt_gen, (unsigned long)s_jrnl_next,
+           (unsigned long)LOG_JRNL_ENTRIES, (unsigned long)st.ckpt_writes);
+    printf("  Appends       : %lu (%lu bytes)\r\n",
+           (unsigned long)st.appends, (unsigned long)st.append_bytes);
+    printf("  GC            : %lu runs (%lu background, %lu wear moves), %lu moved, %lu erased\r\n",
+           (unsigned long)st.gc_runs, (unsigned long)st.gc_bg, (unsigned long)st.gc_wear,
+           (unsigned long)st.gc_moved, (unsigned long)st.gc_erases);
+    printf("  GC slice      : max %lu us (budget %lu us every %lu ms), %s\r\n",
+           (unsigned long)st.gc_slice_max_us, (unsigned long)QSPI_LOG_GC_SLICE_US,
+           (unsigned long)QSPI_LOG_GC_PERIOD_MS,
+           (s_gc.state != GC_IDLE) ? "pass in progress" : "idle");
+}
+
+#endif /* QSPI_LOG_ENABLE */
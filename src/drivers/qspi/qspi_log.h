@@ -0,0 +1,170 @@
+/* qspi_log.h: Log-structured (append-only) object store
+ *
+ * QSPI_Flash_WriteAddr() rewrites an object in place: erase + program every
+ * time. The log store appends instead. Each update of a type_id is a new
+ * record written into pre-erased space, and the record with the highest
+ * sequence number wins. An update costs page programs only; erases happen
+ * when garbage collection reclaims segments whose records are stale.
+ *
+ * Region QSPI_LOG_BASE..+QSPI_LOG_SIZE starts with two checkpoint areas,
+ * the rest is cut into QSPI_LOG_SEG_SIZE segments (one 4 KB sector each):
+ *
+ *   segment: [rec][rec][rec]...[erased]     records packed, QSPI_LOG_ALIGN
+ *   rec:     [qspi_log_hdr_t][payload]
+ *
+ * A record that does not fit in one segment takes a run of consecutive free
+ * segments of its own (a "span"). Nothing else is appended behind it.
+ *
+ * Commit: the header goes out with QSPI_LOG_FLAG_UNCOMMITTED still set,
+ * then the payload, then the flags halfword is programmed again with the bit
+ * cleared (NOR programs only clear bits). A record interrupted by a reset
+ * keeps the bit set and is ignored; its space is reclaimed by GC.
+ *
+ * Mount: a checkpoint holds the segment table and the type index; segment
+ * opens, spans and erases since then are journaled behind it. Mount loads
+ * the newest checkpoint, replays the journal and reads only the records of
+ * the segments opened since, so its time does not grow with the number of
+ * records. Without a checkpoint (first boot, chip erase) it reads every
+ * header once and writes one.
+ *
+ * GC: QSPI_Log_Task() reclaims in the background, a few page copies per
+ * superloop pass. Victims are picked by stale bytes, with worn segments
+ * penalised; new segments are taken least worn first, and cold data stuck on
+ * little-worn segments is moved so those get reused. An append that runs out
+ * of space finishes the pass in the foreground.
+ *
+ * The region is reserved: QSPI_Flash_WriteAddr/EraseRange refuse it.
+ */
+
+#ifndef QSPI_LOG_H
+#define QSPI_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "qspi_flash.h"
+
+/* 1 = build the log store (mounted by QSPI_Flash_Init) */
+#ifndef QSPI_LOG_ENABLE
+#define QSPI_LOG_ENABLE         1
+#endif
+
+/* Behind the QSPI_OBJ_STORE_BASE sectors (1 MB), below the bench scratch */
+#define QSPI_LOG_BASE           (0x100000UL)
+#define QSPI_LOG_SIZE           (0x100000UL)
+#define QSPI_LOG_SEG_SIZE       (4096UL)
+
+/* Per checkpoint area: segment table + index, then the journal. A new
+ * checkpoint is written every QSPI_LOG_JRNL_ENTRIES segment opens/erases,
+ * which bounds what mount has to scan. */
+#define QSPI_LOG_CKPT_SIZE      (8192UL)
+#define QSPI_LOG_JRNL_ENTRIES   (64U)
+#define QSPI_LOG_DATA_BASE      (QSPI_LOG_BASE + (2UL * QSPI_LOG_CKPT_SIZE))
+#define QSPI_LOG_SEGS           ((QSPI_LOG_SIZE - (2UL * QSPI_LOG_CKPT_SIZE)) / QSPI_LOG_SEG_SIZE)
+
+#define QSPI_LOG_MAGIC          (0x31474F4CUL)  /* 'LOG1' */
+#define QSPI_LOG_ALIGN          (16U)
+
+/* RAM index type_id -> newest record (power of two, 3/4 usable) */
+#define QSPI_LOG_INDEX_SLOTS    (128U)
+
+/* Free segments only GC may use, so it can always relocate a segment */
+#define QSPI_LOG_GC_RESERVE     (2U)
+
+/* Background GC (QSPI_Log_Task): a victim is picked every PERIOD_MS, then
+ * worked on for at most SLICE_US per call. A call starts at most one job
+ * (page program, journal entry or sector erase) and returns while it runs.
+ * A checkpoint, due every QSPI_LOG_JRNL_ENTRIES segment changes, is written
+ * blocking in a call of its own (programs only: its area is erased ahead) */
+#define QSPI_LOG_GC_PERIOD_MS   (100U)
+#define QSPI_LOG_GC_SLICE_US    (500U)
+/* Victim score: stale bytes in per mille of the segment, minus WEAR_COST
+ * per erase above the least worn segment. The background only takes
+ * segments scoring MIN_STALE or more, unless free segments are down to
+ * FREE_LOW. */
+#define QSPI_LOG_GC_MIN_STALE   (500U)
+#define QSPI_LOG_GC_FREE_LOW    (8U)
+#define QSPI_LOG_GC_WEAR_COST   (20U)
+/* Move fully live (cold) segments erased this much less than the most worn */
+#define QSPI_LOG_GC_WEAR_DELTA  (64U)
+
+/* flags (active low: programmed to 0 to set the state) */
+#define QSPI_LOG_FLAG_UNCOMMITTED   (0x0001U)   /* cleared by the commit */
+#define QSPI_LOG_FLAG_DATA          (0x0002U)   /* cleared = delete marker */
+
+/*
+ * Record header: the object header of qspi_flash.h (magic QSPI_LOG_MAGIC,
+ * header_len = sizeof(qspi_log_hdr_t)) plus the log sequence number.
+ * header_crc covers all 32 bytes with header_crc = 0 and the UNCOMMITTED
+ * bit set, so the commit does not change it.
+ */
+typedef struct __attribute__((packed))
+{
+    qspi_obj_hdr_t obj;
+    uint32_t       seq;
+} qspi_log_hdr_t;
+
+typedef struct
+{
+    uint32_t segs_free;
+    uint32_t segs_used;             /* holding records (incl. spans) */
+    uint32_t segs_dirty;            /* unknown content, erase pending */
+    uint32_t records;               /* committed records on flash */
+    uint32_t types;                 /* indexed type_ids (incl. deleted) */
+    uint32_t next_seq;
+    uint32_t appends;
+    uint32_t append_bytes;
+    uint32_t gc_runs;
+    uint32_t gc_moved;              /* records relocated */
+    uint32_t gc_erases;             /* segments erased */
+    uint32_t gc_bg;                 /* passes started by QSPI_Log_Task */
+    uint32_t gc_wear;               /* of those, cold-data moves */
+    uint32_t gc_slice_max_us;       /* longest QSPI_Log_Task call */
+    uint32_t mount_us;
+    uint32_t mount_full;            /* 1 = no checkpoint, every header read */
+    uint32_t mount_jrnl;            /* journal entries replayed */
+    uint32_t mount_records;         /* record headers read */
+    uint32_t ckpt_writes;
+} qspi_log_stats_t;
+
+/* Scan the region, find the append position and build the type index.
+ * Called by QSPI_Flash_Init(). */
+bool QSPI_Log_Mount(void);
+
+/* Erase the whole region (blocking) */
+bool QSPI_Log_Format(void);
+
+/* Write a checkpoint now (also done whenever the journal fills up) */
+bool QSPI_Log_Checkpoint(void);
+
+/* Append a new version of type_id (blocking, runs GC if space is short) */
+bool QSPI_Log_Write(uint32_t type_id, uint32_t version, const void *data, uint32_t len);
+
+/* Read the newest version of type_id; payload CRC always checked */
+bool QSPI_Log_Read(uint32_t type_id, void *buf, uint32_t max_len,
+                   uint32_t *len_out, uint32_t *version_out);
+
+/* QSPI_Log_Read() in chunks of buf_len through cb (see QSPI_Flash_ReadStream);
+ * the CRC verdict comes after the last chunk */
+bool QSPI_Log_ReadStream(uint32_t type_id, void *buf, uint32_t buf_len,
+                         qspi_flash_chunk_cb_t cb, void *ctx,
+                         uint32_t *len_out, uint32_t *version_out);
+
+/* Append a delete marker for type_id */
+bool QSPI_Log_Delete(uint32_t type_id);
+
+/* Reclaim one segment (blocking); false if nothing can be reclaimed.
+ * Finishes a background pass first. */
+bool QSPI_Log_Gc(void);
+
+/* Superloop: background GC in bounded slices */
+void QSPI_Log_Task(void);
+
+/* Job engine hook: [addr, addr + len) was erased */
+void QSPI_Log_NoteErase(uint32_t addr, uint32_t len);
+
+bool QSPI_Log_Overlaps(uint32_t addr, uint32_t len);
+void QSPI_Log_GetStats(qspi_log_stats_t *out);
+void QSPI_Log_Print(void);
+
+#endif /* QSPI_LOG_H */
@@ -0,0 +1,704 @@
+/* qspi_sfdp.c: JEDEC SFDP (JESD216) discovery + generic SFDP flash driver */
+
+#include <stdio.h>
+#include <string.h>
+#include "../../common/systick.h"
+#include "qspi_sfdp.h"
+#include "qspi_hw.h"
+
+/* JEDEC-common SPI-protocol opcodes used by the generic driver */
+#define SFDP_CMD_WRITE_ENABLE       (0x06U)
+#define SFDP_CMD_READ_STATUS        (0x05U)
+#define SFDP_CMD_READ_STATUS2       (0x35U)
+#define SFDP_CMD_WRITE_STATUS       (0x01U)
+#define SFDP_CMD_WRITE_STATUS2      (0x31U)
+#define SFDP_CMD_PAGE_PROGRAM       (0x02U)
+#define SFDP_CMD_FAST_READ          (0x0BU)
+#define SFDP_CMD_CHIP_ERASE         (0xC7U)
+#define SFDP_CMD_JEDEC_ID           (0x9FU)
+
+#define SFDP_SR_WIP_Msk             (0x01U)
+#define SFDP_SR1_QE_BIT6_Msk        (0x40U)   /* QER 2 */
+#define SFDP_SR2_QE_BIT1_Msk        (0x02U)   /* QER 1, 4, 5, 6 */
+
+/* Mode bits sent by the generic driver: never a continuous-read pattern */
+#define SFDP_MODE_BITS_NO_CONT      (0xFFU)
+
+/* ---------------- table reading / decoding ---------------- */
+
+static uint32_t sfdp_le32(const uint8_t *p)
+{
+    return ((uint32_t)p[0]) | ((uint32_t)p[1] << 8) |
+           ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static bool sfdp_read_bytes(uint32_t addr, void *dst, uint32_t len)
+{
+    return QSPI_HW_ReadAddr(QSPI_SFDP_CMD_READ,
+                            QSPI_WIDTH_SINGLE_BIT_SPI,
+                            QSPI_ADDRLEN_24BITS,
+                            addr,
+                            QSPI_SFDP_DUMMY_CYCLES,
+                            dst, (size_t)len);
+}
+
+/* Fast-read descriptor halves: [4:0] dummy, [7:5] mode clocks, [15:8] opcode */
+static void sfdp_decode_read(qspi_sfdp_read_t *r, bool supported, uint16_t half)
+{
+    r->supported    = supported;
+    r->dummy_clocks = (uint8_t)(half & 0x1FU);
+    r->mode_clocks  = (uint8_t)((half >> 5) & 0x07U);
+    r->opcode       = (uint8_t)(half >> 8);
+}
+
+static uint32_t sfdp_density_bytes(uint32_t dw2)
+{
+    if ((dw2 & 0x80000000UL) == 0U)
+    {
+        return (dw2 + 1U) / 8U;        /* N+1 bits, N < 2^31 */
+    }
+
+    uint32_t n = dw2 & 0x7FFFFFFFUL;   /* 2^n bits */
+    if (n < 3U)
+        return 0U;
+    if ((n - 3U) >= 32U)
+        return 0xFFFFFFFFUL;
+    return 1UL << (n - 3U);
+}
+
+static void sfdp_decode_bfpt(qspi_sfdp_info_t *info, const uint32_t *dw, uint32_t n)
+{
+    /* DWORD1: 4K erase, address bytes, fast-read support bits */
+    info->erase_4k        = ((dw[0] & 0x3U) == 0x1U);
+    info->erase_4k_opcode = (uint8_t)(dw[0] >> 8);
+    info->addr            = (qspi_sfdp_addr_t)((dw[0] >> 17) & 0x3U);
+
+    /* DWORD2: density */
+    info->capacity = sfdp_density_bytes(dw[1]);
+
+    /* DWORD3..7: fast-read opcodes / clocks */
+    sfdp_decode_read(&info->read[QSPI_SFDP_READ_1_4_4], (dw[0] & (1UL << 21)) != 0U, (uint16_t)dw[2]);
+    sfdp_decode_read(&info->read[QSPI_SFDP_READ_1_1_4], (dw[0] & (1UL << 22)) != 0U, (uint16_t)(dw[2] >> 16));
+    sfdp_decode_read(&info->read[QSPI_SFDP_READ_1_1_2], (dw[0] & (1UL << 16)) != 0U, (uint16_t)dw[3]);
+    sfdp_decode_read(&info->read[QSPI_SFDP_READ_1_2_2], (dw[0] & (1UL << 20)) != 0U, (uint16_t)(dw[3] >> 16));
+    sfdp_decode_read(&info->read[QSPI_SFDP_READ_2_2_2], (dw[4] & (1UL << 0)) != 0U,  (uint16_t)(dw[5] >> 16));
+    sfdp_decode_read(&info->read[QSPI_SFDP_READ_4_4_4], (dw[4] & (1UL << 4)) != 0U,  (uint16_t)(dw[6] >> 16));
+
+    /* DWORD8..9: erase types (size = 2^N, N = 0 -> not present) */
+    for (uint32_t i = 0; i < 4U; i++)
+    {
+        uint16_t half = (uint16_t)(dw[7U + (i / 2U)] >> ((i & 1U) * 16U));
+        uint8_t  nexp = (uint8_t)half;
+
+        info->erase[i].size   = ((nexp != 0U) && (nexp < 32U)) ? (1UL << nexp) : 0U;
+        info->erase[i].opcode = (uint8_t)(half >> 8);
+    }
+
+    /* DWORD11 (JESD216A+): page size = 2^N in [7:4] */
+    info->page_size = 256U;
+    if (n >= 11U)
+    {
+        info->page_size = 1UL << ((dw[10] >> 4) & 0x0FU);
+
+        /* DWORD10: erase type i typical time in [10+7i:4+7i]
+         * (count [4:0] + 1, unit [6:5] = 1 ms / 16 ms / 128 ms / 1 s) */
+        static const uint32_t erase_unit_us[4] = { 1000UL, 16000UL, 128000UL, 1000000UL };
+        for (uint32_t i = 0; i < 4U; i++)
+        {
+            uint32_t f = (dw[9] >> (4U + (7U * i))) & 0x7FU;
+            if (info->erase[i].size != 0U)
+                info->erase[i].typ_us = ((f & 0x1FU) + 1U) * erase_unit_us[f >> 5];
+        }
+        info->erase_max_mult = (uint8_t)(dw[9] & 0x0FU);
+        info->prog_max_mult  = (uint8_t)(dw[10] & 0x0FU);
+
+        /* DWORD11: page program [13:8] (count + 1, unit 8 / 64 us),
+         * chip erase [30:24] (count + 1, unit 16 ms / 256 ms / 4 s / 64 s) */
+        static const uint32_t chip_unit_ms[4] = { 16UL, 256UL, 4000UL, 64000UL };
+        uint32_t pp = (dw[10] >> 8) & 0x3FU;
+        uint32_t ce = (dw[10] >> 24) & 0x7FU;
+        info->prog_typ_us       = ((pp & 0x1FU) + 1U) * (((pp & 0x20U) != 0U) ? 64UL : 8UL);
+        info->chip_erase_typ_ms = ((ce & 0x1FU) + 1U) * chip_unit_ms[ce >> 5];
+    }
+
+    /* DWORD12 bit31 = 0: suspend/resume supported; DWORD13 holds the
+     * erase suspend [31:24] / resume [23:16] instructions */
+    if (n >= 13U)
+    {
+        info->suspend        = ((dw[11] & 0x80000000UL) == 0U);
+        info->suspend_opcode = (uint8_t)(dw[12] >> 24);
+        info->resume_opcode  = (uint8_t)(dw[12] >> 16);
+    }
+
+    /* DWORD15 (JESD216A+): Quad Enable requirement */
+    info->quad_enable_req = QSPI_SFDP_QER_UNKNOWN;
+    if (n >= 15U)
+    {
+        info->quad_enable_req = (uint8_t)((dw[14] >> 20) & 0x07U);
+    }
+}
+
+bool QSPI_SFDP_Read(qspi_sfdp_info_t *info)
+{
+    uint8_t hdr[8U + (8U * QSPI_SFDP_MAX_PARAM_HDRS)];
+    uint32_t dw[QSPI_SFDP_BFPT_MAX_DWORDS];
+
+    if (info == NULL)
+        return false;
+
+    memset(info, 0, sizeof(*info));
+    info->quad_enable_req = QSPI_SFDP_QER_UNKNOWN;
+
+    if (!sfdp_read_bytes(0U, hdr, sizeof(hdr)))
+        return false;
+
+    if (sfdp_le32(&hdr[0]) != QSPI_SFDP_SIGNATURE)
+        return false;
+
+    info->rev_minor = hdr[4];
+    info->rev_major = hdr[5];
+
+    uint32_t nph = (uint32_t)hdr[6] + 1U;
+    if (nph > QSPI_SFDP_MAX_PARAM_HDRS)
+        nph = QSPI_SFDP_MAX_PARAM_HDRS;
+
+    /* Parameter header: ID LSB, minor, major, length (DWORDs), PTP[3], ID MSB */
+    for (uint32_t i = 0; i < nph; i++)
+    {
+        const uint8_t *ph = &hdr[8U + (8U * i)];
+        uint16_t id  = (uint16_t)(((uint16_t)ph[7] << 8) | ph[0]);
+        uint32_t len = ph[3];
+        uint32_t ptp = ((uint32_t)ph[4]) | ((uint32_t)ph[5] << 8) | ((uint32_t)ph[6] << 16);
+
+        if ((id != QSPI_SFDP_BFPT_ID) || (len < 9U))
+            continue;
+
+        if (len > QSPI_SFDP_BFPT_MAX_DWORDS)
+            len = QSPI_SFDP_BFPT_MAX_DWORDS;
+
+        uint8_t raw[QSPI_SFDP_BFPT_MAX_DWORDS * 4U];
+        if (!sfdp_read_bytes(ptp, raw, len * 4U))
+            return false;
+
+        for (uint32_t k = 0; k < len; k++)
+        {
+            dw[k] = sfdp_le32(&raw[k * 4U]);
+        }
+
+        info->bfpt_dwords = (uint8_t)len;
+        sfdp_decode_bfpt(info, dw, len);
+        info->valid = (info->capacity != 0U);
+        return info->valid;
+    }
+
+    return false;
+}
+
+uint32_t QSPI_SFDP_MinErase(const qspi_sfdp_info_t *info, uint8_t *opcode_out)
+{
+    uint32_t best = 0U;
+    uint8_t  op   = 0U;
+
+    if ((info == NULL) || !info->valid)
+        return 0U;
+
+    for (uint32_t i = 0; i < 4U; i++)
+    {
+        if ((info->erase[i].size != 0U) && ((best == 0U) || (info->erase[i].size < best)))
+        {
+            best = info->erase[i].size;
+            op   = info->erase[i].opcode;
+        }
+    }
+
+    /* JESD216 v1.0 parts may only describe 4K erase in DWORD1 */
+    if ((best == 0U) && info->erase_4k)
+    {
+        best = 4096U;
+        op   = info->erase_4k_opcode;
+    }
+
+    if (opcode_out != NULL)
+        *opcode_out = op;
+    return best;
+}
+
+const char *QSPI_SFDP_ReadModeName(qspi_sfdp_read_mode_t mode)
+{
+    switch (mode)
+    {
+        case QSPI_SFDP_READ_1_1_2: return "1-1-2";
+        case QSPI_SFDP_READ_1_2_2: return "1-2-2";
+        case QSPI_SFDP_READ_1_1_4: return "1-1-4";
+        case QSPI_SFDP_READ_1_4_4: return "1-4-4";
+        case QSPI_SFDP_READ_2_2_2: return "2-2-2";
+        case QSPI_SFDP_READ_4_4_4: return "4-4-4";
+        default:                   return "1-1-1";
+    }
+}
+
+void QSPI_SFDP_Print(const qspi_sfdp_info_t *info)
+{
+    static const char * const addr_str[] = { "3-byte", "3/4-byte", "4-byte", "?" };
+
+    if ((info == NULL) || !info->valid)
+    {
+        printf("SFDP            : not available\r\n");
+        return;
+    }
+
+    printf("SFDP            : rev %u.%u, BFPT %u DWORDs\r\n",
+           (unsigned)info->rev_major, (unsigned)info->rev_minor,
+           (unsigned)info->bfpt_dwords);
+    printf("  Density       : %lu KB, page %lu, %s address\r\n",
+           (unsigned long)(info->capacity / 1024UL),
+           (unsigned long)info->page_size,
+           addr_str[(uint32_t)info->addr & 3U]);
+
+    printf("  Erase types   :");
+    for (uint32_t i = 0; i < 4U; i++)
+    {
+        if (info->erase[i].size != 0U)
+        {
+            printf(" %luK=0x%02X",
+                   (unsigned long)(info->erase[i].size / 1024UL),
+                   (unsigned)info->erase[i].opcode);
+        }
+    }
+    printf("\r\n");
+
+    if (info->prog_typ_us != 0U)
+    {
+        printf("  Typ. times    : page %lu us (max x%u), chip %lu ms (max x%u)\r\n",
+               (unsigned long)info->prog_typ_us,
+               (unsigned)(2U * (info->prog_max_mult + 1U)),
+               (unsigned long)info->chip_erase_typ_ms,
+               (unsigned)(2U * (info->erase_max_mult + 1U)));
+    }
+
+    for (uint32_t m = 0; m < (uint32_t)QSPI_SFDP_READ_COUNT; m++)
+    {
+        const qspi_sfdp_read_t *r = &info->read[m];
+        if (!r->supported)
+            continue;
+        printf("  Read %s   : op=0x%02X mode=%u dummy=%u\r\n",
+               QSPI_SFDP_ReadModeName((qspi_sfdp_read_mode_t)m),
+               (unsigned)r->opcode,
+               (unsigned)r->mode_clocks,
+               (unsigned)r->dummy_clocks);
+    }
+
+    if (info->quad_enable_req != QSPI_SFDP_QER_UNKNOWN)
+    {
+        printf("  Quad Enable   : QER %u\r\n", (unsigned)info->quad_enable_req);
+    }
+    if (info->suspend)
+    {
+        printf("  Suspend       : 0x%02X / resume 0x%02X\r\n",
+               (unsigned)info->suspend_opcode, (unsigned)info->resume_opcode);
+    }
+}
+
+/* ---------------- generic SFDP driver ---------------- */
+
+typedef struct
+{
+    uint8_t      opcode;
+    qspi_width_t width;
+    bool         opt_en;
+    uint8_t      optlen;        /* QSPI_INSTRFRAME_OPTCODELEN_xxx_Val */
+    uint8_t      dummy_cycles;
+} sfdp_read_cfg_t;
+
+static qspi_sfdp_info_t s_gen_info;
+static qspi_flash_ops_t s_gen_ops;
+static sfdp_read_cfg_t  s_gen_read;
+static uint8_t          s_gen_erase_opcode;
+static bool             s_gen_suspended;
+static qspi_busy_timing_t s_gen_timing[QSPI_BUSY_OP_COUNT];
+
+static bool sfdp_gen_write_enable(void)
+{
+    return QSPI_HW_Command(SFDP_CMD_WRITE_ENABLE, QSPI_WIDTH_SINGLE_BIT_SPI);
+}
+
+static bool sfdp_gen_read_status(uint8_t *sr_out)
+{
+    if (sr_out == NULL)
+        return false;
+    return QSPI_HW_Read(SFDP_CMD_READ_STATUS, QSPI_WIDTH_SINGLE_BIT_SPI, sr_out, 1U);
+}
+
+static bool sfdp_gen_wait_ready(qspi_busy_op_t op)
+{
+    if ((uint32_t)op >= (uint32_t)QSPI_BUSY_OP_COUNT)
+        return false;
+    return QSPI_HW_WaitReady(sfdp_gen_read_status, SFDP_SR_WIP_Msk, op, &s_gen_timing[op]);
+}
+
+static bool sfdp_gen_read_jedec(uint32_t *jedec_out)
+{
+    uint8_t id[3] = { 0U, 0U, 0U };
+
+    if (jedec_out == NULL)
+        return false;
+    if (!QSPI_HW_Read(SFDP_CMD_JEDEC_ID, QSPI_WIDTH_SINGLE_BIT_SPI, id, sizeof(id)))
+        return false;
+
+    *jedec_out = ((uint32_t)id[0]) | ((uint32_t)id[1] << 8) | ((uint32_t)id[2] << 16);
+    return true;
+}
+
+/* Set the QE bit the way DWORD15 says. QER 3 (SR2 bit7 via 3Eh/3Fh) and
+ * parts without DWORD15 are not handled: quad reads are then not used. */
+static bool sfdp_gen_quad_enable(void)
+{
+    uint8_t sr[2] = { 0U, 0U };
+
+    switch (s_gen_info.quad_enable_req)
+    {
+        case 0U:    /* no QE bit (quad pins dedicated / always on) */
+            return true;
+
+        case 2U:    /* SR1 bit6, 01h with one byte */
+            if (!sfdp_gen_read_status(&sr[0]))
+                return false;
+            if ((sr[0] & SFDP_SR1_QE_BIT6_Msk) != 0U)
+                return true;
+            sr[0] |= SFDP_SR1_QE_BIT6_Msk;
+            if (!sfdp_gen_write_enable() ||
+                !QSPI_HW_Write(SFDP_CMD_WRITE_STATUS, QSPI_WIDTH_SINGLE_BIT_SPI, sr, 1U))
+                return false;
+            break;
+
+        case 1U:    /* SR2 bit1, 01h with two bytes */
+        case 4U:
+        case 5U:
+            if (!sfdp_gen_read_status(&sr[0]) ||
+                !QSPI_HW_Read(SFDP_CMD_READ_STATUS2, QSPI_WIDTH_SINGLE_BIT_SPI, &sr[1], 1U))
+                return false;
+            if ((sr[1] & SFDP_SR2_QE_BIT1_Msk) != 0U)
+                return true;
+            sr[1] |= SFDP_SR2_QE_BIT1_Msk;
+            if (!sfdp_gen_write_enable() ||
+                !QSPI_HW_Write(SFDP_CMD_WRITE_STATUS, QSPI_WIDTH_SINGLE_BIT_SPI, sr, 2U))
+                return false;
+            break;
+
+        case 6U:    /* SR2 bit1, 31h with one byte */
+            if (!QSPI_HW_Read(SFDP_CMD_READ_STATUS2, QSPI_WIDTH_SINGLE_BIT_SPI, &sr[1], 1U))
+                return false;
+            if ((sr[1] & SFDP_SR2_QE_BIT1_Msk) != 0U)
+                return true;
+            sr[1] |= SFDP_SR2_QE_BIT1_Msk;
+            if (!sfdp_gen_write_enable() ||
+                !QSPI_HW_Write(SFDP_CMD_WRITE_STATUS2, QSPI_WIDTH_SINGLE_BIT_SPI, &sr[1], 1U))
+                return false;
+            break;
+
+        default:
+            return false;
+    }
+
+    return sfdp_gen_wait_ready(QSPI_BUSY_REG_WRITE);
+}
+
+/* Mode clocks are sent as option code bits (0xFF, never a continuous-read
+ * pattern) when they fit OPTCODELEN; otherwise they are left as dummies. */
+static void sfdp_gen_set_read(qspi_sfdp_read_mode_t mode)
+{
+    static const qspi_width_t width_map[] =
+    {
+        [QSPI_SFDP_READ_1_1_2] = QSPI_WIDTH_DUAL_OUTPUT,
+        [QSPI_SFDP_READ_1_2_2] = QSPI_WIDTH_DUAL_IO,
+        [QSPI_SFDP_READ_1_1_4] = QSPI_WIDTH_QUAD_OUTPUT,
+        [QSPI_SFDP_READ_1_4_4] = QSPI_WIDTH_QUAD_IO,
+    };
+
+    if ((mode != QSPI_SFDP_READ_1_1_2) && (mode != QSPI_SFDP_READ_1_2_2) &&
+        (mode != QSPI_SFDP_READ_1_1_4) && (mode != QSPI_SFDP_READ_1_4_4))
+    {
+        s_gen_read.opcode       = SFDP_CMD_FAST_READ;
+        s_gen_read.width        = QSPI_WIDTH_SINGLE_BIT_SPI;
+        s_gen_read.opt_en       = false;
+        s_gen_read.optlen       = 0U;
+        s_gen_read.dummy_cycles = 8U;
+        return;
+    }
+
+    const qspi_sfdp_read_t *r = &s_gen_info.read[mode];
+    uint32_t lines = (mode == QSPI_SFDP_READ_1_4_4) ? 4U :
+                     (mode == QSPI_SFDP_READ_1_2_2) ? 2U : 1U;
+    uint32_t mode_bits = (uint32_t)r->mode_clocks * lines;
+
+    s_gen_read.opcode       = r->opcode;
+    s_gen_read.width        = width_map[mode];
+    s_gen_read.opt_en       = true;
+    s_gen_read.dummy_cycles = r->dummy_clocks;
+
+    switch (mode_bits)
+    {
+        case 1U: s_gen_read.optlen = (uint8_t)QSPI_INSTRFRAME_OPTCODELEN_1BIT_Val;  break;
+        case 2U: s_gen_read.optlen = (uint8_t)QSPI_INSTRFRAME_OPTCODELEN_2BITS_Val; break;
+        case 4U: s_gen_read.optlen = (uint8_t)QSPI_INSTRFRAME_OPTCODELEN_4BITS_Val; break;
+        case 8U: s_gen_read.optlen = (uint8_t)QSPI_INSTRFRAME_OPTCODELEN_8BITS_Val; break;
+        default:
+            s_gen_read.opt_en        = false;
+            s_gen_read.optlen        = 0U;
+            s_gen_read.dummy_cycles += r->mode_clocks;
+            break;
+    }
+}
+
+/* Fastest SPI-protocol read first; quad modes only if QE could be set */
+static bool sfdp_gen_init(void)
+{
+    static const qspi_sfdp_read_mode_t order[] =
+    {
+        QSPI_SFDP_READ_1_4_4, QSPI_SFDP_READ_1_1_4,
+        QSPI_SFDP_READ_1_2_2, QSPI_SFDP_READ_1_1_2,
+    };
+    qspi_sfdp_read_mode_t chosen = QSPI_SFDP_READ_COUNT;
+
+    for (uint32_t i = 0; i < (sizeof(order) / sizeof(order[0])); i++)
+    {
+        qspi_sfdp_read_mode_t m = order[i];
+        bool quad = (m == QSPI_SFDP_READ_1_4_4) || (m == QSPI_SFDP_READ_1_1_4);
+
+        if (!s_gen_info.read[m].supported)
+            continue;
+        if (quad && !sfdp_gen_quad_enable())
+        {
+            printf("[QSPI] SFDP: quad enable (QER %u) not supported\r\n",
+                   (unsigned)s_gen_info.quad_enable_req);
+            continue;
+        }
+        chosen = m;
+        break;
+    }
+
+    sfdp_gen_set_read(chosen);
+    printf("[QSPI] SFDP: generic driver, read %s op=0x%02X dummy=%u\r\n",
+           QSPI_SFDP_ReadModeName(chosen),
+           (unsigned)s_gen_read.opcode,
+           (unsigned)s_gen_read.dummy_cycles);
+    return true;
+}
+
+static bool sfdp_gen_read(void *rx, uint32_t len, uint32_t address)
+{
+    if ((rx == NULL) || (len == 0U))
+        return false;
+
+    return QSPI_HW_MemoryRead(s_gen_read.opcode,
+                              s_gen_read.width,
+                              QSPI_ADDRLEN_24BITS,
+                              s_gen_read.opt_en,
+                              SFDP_MODE_BITS_NO_CONT,
+                              s_gen_read.optlen,
+                              s_gen_read.dummy_cycles,
+                              rx, (size_t)len,
+                              address);
+}
+
+static bool sfdp_gen_program(const void *tx, uint32_t len, uint32_t address)
+{
+    if ((tx == NULL) || (len == 0U))
+        return false;
+
+    if (!sfdp_gen_write_enable())
+        return false;
+
+    return QSPI_HW_MemoryWrite(SFDP_CMD_PAGE_PROGRAM,
+                               QSPI_WIDTH_SINGLE_BIT_SPI,
+                               QSPI_ADDRLEN_24BITS,
+                               false, 0, 0,
+                               0,
+                               tx, (size_t)len,
+                               address);
+}
+
+static bool sfdp_gen_erase_sector(uint32_t address)
+{
+    if (!sfdp_gen_write_enable())
+        return false;
+
+    return QSPI_HW_CommandAddr(s_gen_erase_opcode,
+                               QSPI_WIDTH_SINGLE_BIT_SPI,
+                               QSPI_ADDRLEN_24BITS,
+                               address);
+}
+
+/* Largest SFDP erase type that is aligned at address and fits in len */
+static uint32_t sfdp_gen_block_fit(uint32_t address, uint32_t len)
+{
+    uint32_t best = 0U;
+
+    for (uint32_t i = 0; i < 4U; i++)
+    {
+        uint32_t sz = s_gen_info.erase[i].size;
+        if ((sz > s_gen_ops.sector_size) && (sz > best) &&
+            ((address & (sz - 1U)) == 0U) && (sz <= len))
+        {
+            best = sz;
+        }
+    }
+    return best;
+}
+
+static bool sfdp_gen_erase_block(uint32_t address, uint32_t size)
+{
+    for (uint32_t i = 0; i < 4U; i++)
+    {
+        if (s_gen_info.erase[i].size == size)
+        {
+            if (!sfdp_gen_write_enable())
+                return false;
+            return QSPI_HW_CommandAddr(s_gen_info.erase[i].opcode,
+                                       QSPI_WIDTH_SINGLE_BIT_SPI,
+                                       QSPI_ADDRLEN_24BITS,
+                                       address);
+        }
+    }
+    return false;
+}
+
+static bool sfdp_gen_chip_erase_start(void)
+{
+    return sfdp_gen_write_enable() &&
+           QSPI_HW_Command(SFDP_CMD_CHIP_ERASE, QSPI_WIDTH_SINGLE_BIT_SPI);
+}
+
+static bool sfdp_gen_chip_erase(void)
+{
+    if (!sfdp_gen_chip_erase_start())
+        return false;
+
+    uint32_t t0 = millis();
+    if (sfdp_gen_wait_ready(QSPI_BUSY_CHIP_ERASE))
+    {
+        printf("[QSPI] SFDP chip erase done in %lu ms\r\n",
+               (unsigned long)(millis() - t0));
+        return true;
+    }
+
+    printf("[QSPI] SFDP chip erase TIMEOUT\r\n");
+    return false;
+}
+
+static bool sfdp_gen_suspend(void)
+{
+    uint8_t sr = 0;
+
+    if (!sfdp_gen_read_status(&sr))
+        return false;
+    if ((sr & SFDP_SR_WIP_Msk) == 0U)
+        return true;
+
+    if (!QSPI_HW_Command(s_gen_info.suspend_opcode, QSPI_WIDTH_SINGLE_BIT_SPI))
+        return false;
+
+    s_gen_suspended = true;
+    return sfdp_gen_wait_ready(QSPI_BUSY_SUSPEND);
+}
+
+static bool sfdp_gen_resume(void)
+{
+    if (!s_gen_suspended)
+        return true;
+
+    s_gen_suspended = false;
+    return QSPI_HW_Command(s_gen_info.resume_opcode, QSPI_WIDTH_SINGLE_BIT_SPI);
+}
+
+/* typ from SFDP (0 = unknown), max = the larger of the SFDP max and dflt_max_us */
+static void sfdp_gen_set_timing(qspi_busy_op_t op, uint32_t typ_us, uint8_t mult,
+                                uint32_t dflt_max_us)
+{
+    uint64_t max = 2ULL * (uint64_t)(mult + 1U) * typ_us;
+
+    if (max < dflt_max_us)
+        max = dflt_max_us;
+    if (max > 0xFFFFFFFFULL)
+        max = 0xFFFFFFFFULL;
+
+    s_gen_timing[op].typ_us = typ_us;
+    s_gen_timing[op].max_us = (uint32_t)max;
+}
+
+static void sfdp_gen_build_timing(uint32_t erase_sz)
+{
+    uint32_t sector_typ = 0U;
+    uint32_t block_typ  = 0U;
+    uint32_t block_sz   = 0U;
+
+    for (uint32_t i = 0; i < 4U; i++)
+    {
+        const qspi_sfdp_erase_t *e = &s_gen_info.erase[i];
+        if (e->size == erase_sz)
+            sector_typ = e->typ_us;
+        else if (e->size > block_sz)
+        {
+            block_sz  = e->size;
+            block_typ = e->typ_us;
+        }
+    }
+
+    uint32_t chip_typ_us = (s_gen_info.chip_erase_typ_ms > (0xFFFFFFFFUL / 1000UL)) ?
+                           0xFFFFFFFFUL : (s_gen_info.chip_erase_typ_ms * 1000UL);
+
+    const uint8_t em = s_gen_info.erase_max_mult;
+
+    sfdp_gen_set_timing(QSPI_BUSY_PAGE_PROG,    s_gen_info.prog_typ_us, s_gen_info.prog_max_mult,
+                        QSPI_SFDP_PAGE_PROG_TIMEOUT_US);
+    sfdp_gen_set_timing(QSPI_BUSY_SECTOR_ERASE, sector_typ,  em, QSPI_SFDP_SECTOR_ERASE_TIMEOUT_US);
+    sfdp_gen_set_timing(QSPI_BUSY_BLOCK_ERASE,  block_typ,   em, QSPI_SFDP_BLOCK_ERASE_TIMEOUT_US);
+    sfdp_gen_set_timing(QSPI_BUSY_CHIP_ERASE,   chip_typ_us, em,
+                        QSPI_SFDP_CHIP_ERASE_TIMEOUT_MS * 1000UL);
+    sfdp_gen_set_timing(QSPI_BUSY_REG_WRITE,    0U, 0U, QSPI_SFDP_REG_WRITE_TIMEOUT_US);
+    sfdp_gen_set_timing(QSPI_BUSY_SUSPEND,      0U, 0U, QSPI_SFDP_SUSPEND_TIMEOUT_US);
+}
+
+const qspi_flash_ops_t *QSPI_SFDP_GenericOps(const qspi_sfdp_info_t *info, uint32_t jedec)
+{
+    uint8_t  erase_op = 0U;
+    uint32_t erase_sz;
+
+    if ((info == NULL) || !info->valid || (info->addr == QSPI_SFDP_ADDR_4B))
+        return NULL;
+
+    erase_sz = QSPI_SFDP_MinErase(info, &erase_op);
+    if (erase_sz == 0U)
+        return NULL;
+
+    s_gen_info         = *info;
+    s_gen_erase_opcode = erase_op;
+    sfdp_gen_build_timing(erase_sz);
+
+    memset(&s_gen_ops, 0, sizeof(s_gen_ops));
+    s_gen_ops.name               = "SFDP generic";
+    s_gen_ops.jedec_id           = jedec;
+    /* 3-byte addressing only: parts above 16 MB expose their low 16 MB */
+    s_gen_ops.capacity           = (info->capacity > 0x01000000UL) ? 0x01000000UL : info->capacity;
+    s_gen_ops.sector_size        = erase_sz;
+    s_gen_ops.page_size          = info->page_size;
+    s_gen_ops.timing             = s_gen_timing;
+
+    s_gen_ops.init               = sfdp_gen_init;
+    s_gen_ops.quad_enable        = sfdp_gen_quad_enable;
+    s_gen_ops.read_jedec         = sfdp_gen_read_jedec;
+    s_gen_ops.read_status        = sfdp_gen_read_status;
+    s_gen_ops.wait_ready         = sfdp_gen_wait_ready;
+    s_gen_ops.read               = sfdp_gen_read;
+    s_gen_ops.read_cont          = NULL;
+    s_gen_ops.program            = sfdp_gen_program;
+    s_gen_ops.erase_sector       = sfdp_gen_erase_sector;
+    s_gen_ops.block_fit          = sfdp_gen_block_fit;
+    s_gen_ops.erase_block        = sfdp_gen_erase_block;
+    s_gen_ops.chip_erase         = sfdp_gen_chip_erase;
+    s_gen_ops.chip_erase_start   = sfdp_gen_chip_erase_start;
+    s_gen_ops.suspend            = info->suspend ? sfdp_gen_suspend : NULL;
+    s_gen_ops.resume             = info->suspend ? sfdp_gen_resume  : NULL;
+
+    return &s_gen_ops;
+}
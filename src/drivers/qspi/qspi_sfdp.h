@@ -0,0 +1,130 @@
+/* qspi_sfdp.h: JEDEC SFDP (JESD216) discovery + generic SFDP flash driver
+ *
+ * QSPI_SFDP_Read() reads the SFDP header and the Basic Flash Parameter Table
+ * (BFPT) with 5Ah in 1-1-1 (3-byte address, 8 dummy clocks) and decodes:
+ *  - density, page size, 3/4-byte addressing
+ *  - erase types (size + opcode), 4K erase opcode
+ *  - fast-read modes 1-1-2 .. 4-4-4 (opcode, mode clocks, dummy clocks)
+ *  - erase/program suspend opcodes (DWORD12/13, JESD216A and later)
+ *  - Quad Enable requirement (DWORD15, JESD216A and later)
+ *
+ * QSPI_Flash_Init() takes the geometry of the detected part from here, and a
+ * part with no dedicated driver runs on QSPI_SFDP_GenericOps(): SPI-protocol
+ * (1-x-x) commands only, reads in the fastest mode the table advertises.
+ *
+ * The flash must be in its single-bit protocol when QSPI_SFDP_Read() runs.
+ */
+
+#ifndef QSPI_SFDP_H
+#define QSPI_SFDP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "qspi_flash_ops.h"
+
+#define QSPI_SFDP_CMD_READ          (0x5AU)
+#define QSPI_SFDP_DUMMY_CYCLES      (8U)
+#define QSPI_SFDP_SIGNATURE         (0x50444653UL)  /* "SFDP" little-endian */
+#define QSPI_SFDP_BFPT_ID           (0xFF00U)       /* MSB:LSB parameter ID */
+
+/* Header + up to this many parameter headers are fetched */
+#define QSPI_SFDP_MAX_PARAM_HDRS    (4U)
+/* BFPT DWORDs decoded (JESD216B defines 16, later revisions more) */
+#define QSPI_SFDP_BFPT_MAX_DWORDS   (16U)
+
+/* Timeouts for the generic driver; SFDP typical/max times (DWORD10/11)
+ * are used on top when the table has them */
+#define QSPI_SFDP_PAGE_PROG_TIMEOUT_US      (20000UL)
+#define QSPI_SFDP_SECTOR_ERASE_TIMEOUT_US   (1000000UL)
+#define QSPI_SFDP_BLOCK_ERASE_TIMEOUT_US    (3000000UL)
+#define QSPI_SFDP_REG_WRITE_TIMEOUT_US      (100000UL)
+#define QSPI_SFDP_SUSPEND_TIMEOUT_US        (500UL)
+#ifndef QSPI_SFDP_CHIP_ERASE_TIMEOUT_MS
+#define QSPI_SFDP_CHIP_ERASE_TIMEOUT_MS (480000UL)
+#endif
+
+typedef enum
+{
+    QSPI_SFDP_READ_1_1_2 = 0,
+    QSPI_SFDP_READ_1_2_2,
+    QSPI_SFDP_READ_1_1_4,
+    QSPI_SFDP_READ_1_4_4,
+    QSPI_SFDP_READ_2_2_2,
+    QSPI_SFDP_READ_4_4_4,
+    QSPI_SFDP_READ_COUNT
+} qspi_sfdp_read_mode_t;
+
+typedef struct
+{
+    bool    supported;
+    uint8_t opcode;
+    uint8_t mode_clocks;
+    uint8_t dummy_clocks;   /* wait states after the mode clocks */
+} qspi_sfdp_read_t;
+
+typedef struct
+{
+    uint32_t size;          /* 0 = erase type not present */
+    uint8_t  opcode;
+    uint32_t typ_us;        /* DWORD10 typical time, 0 = unknown */
+} qspi_sfdp_erase_t;
+
+typedef enum
+{
+    QSPI_SFDP_ADDR_3B = 0,
+    QSPI_SFDP_ADDR_3B_OR_4B,
+    QSPI_SFDP_ADDR_4B,
+} qspi_sfdp_addr_t;
+
+/* DWORD15[22:20] Quad Enable requirement */
+#define QSPI_SFDP_QER_UNKNOWN       (0xFFU)
+
+typedef struct
+{
+    bool              valid;
+    uint8_t           rev_major;
+    uint8_t           rev_minor;
+    uint8_t           bfpt_dwords;      /* DWORDs actually decoded */
+
+    uint32_t          capacity;         /* bytes; clamped to 4 GB - 1 */
+    uint32_t          page_size;        /* 256 when DWORD11 is absent */
+    qspi_sfdp_addr_t  addr;
+
+    bool              erase_4k;
+    uint8_t           erase_4k_opcode;
+    qspi_sfdp_erase_t erase[4];
+
+    qspi_sfdp_read_t  read[QSPI_SFDP_READ_COUNT];
+    uint8_t           quad_enable_req;  /* 0..6, or QSPI_SFDP_QER_UNKNOWN */
+
+    /* DWORD10/11 (JESD216A+): typical times, 0 = unknown;
+     * max = 2 * (mult + 1) * typical */
+    uint32_t          prog_typ_us;      /* page program */
+    uint32_t          chip_erase_typ_ms;
+    uint8_t           erase_max_mult;   /* erase types + chip erase */
+    uint8_t           prog_max_mult;
+
+    /* DWORD12/13 (JESD216A+): erase/program suspend */
+    bool              suspend;
+    uint8_t           suspend_opcode;
+    uint8_t           resume_opcode;
+} qspi_sfdp_info_t;
+
+/* Read + decode SFDP. Returns false (info->valid = false) if absent/invalid. */
+bool QSPI_SFDP_Read(qspi_sfdp_info_t *info);
+
+/* Smallest erase type; returns its size (0 if none) and opcode */
+uint32_t QSPI_SFDP_MinErase(const qspi_sfdp_info_t *info, uint8_t *opcode_out);
+
+const char *QSPI_SFDP_ReadModeName(qspi_sfdp_read_mode_t mode);
+void QSPI_SFDP_Print(const qspi_sfdp_info_t *info);
+
+/*
+ * Operations table for a part without its own driver, built from @info.
+ * Returns NULL if the part cannot be driven generically (4-byte-only
+ * addressing, no erase type). jedec goes into ops->jedec_id.
+ */
+const qspi_flash_ops_t *QSPI_SFDP_GenericOps(const qspi_sfdp_info_t *info, uint32_t jedec);
+
+#endif /* QSPI_SFDP_H */
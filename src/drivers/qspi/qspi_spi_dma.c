@@ -0,0 +1,241 @@
+/* qspi_spi_dma.c: QSPI SPI-mode streaming with DMAC TX/RX triggers
+ *
+ * Descriptor chain per channel (header phase only when cmd_len != 0):
+ *
+ *   TX: [cmd bytes, SRCINC] -> [payload or fill byte, SRCINC if payload] -> TXDATA
+ *   RX: RXDATA -> [discard byte, no INC]  -> [payload or discard, DSTINC if payload]
+ *
+ * Base descriptors live in the shared DMAC table (uart_dma.c), the second
+ * (tail) descriptor of each chain is local. Only the RX tail raises an IRQ.
+ */
+
+#include <string.h>
+#include "qspi_spi_dma.h"
+#include "../uart_dma.h"
+#include "../../common/systick.h"
+
+#if (QSPI_SPI_DMA_RX_CHANNEL != 1)
+#error "QSPI SPI DMA completion is handled in DMAC_1_Handler (RX channel must be 1)"
+#endif
+
+#define QSPI_SPI_DMA_CMD_MAX    (8U)
+
+__attribute__((aligned(DMA_DESCRIPTOR_ALIGN)))
+static DmacDescriptor_t s_rx_tail;
+
+__attribute__((aligned(DMA_DESCRIPTOR_ALIGN)))
+static DmacDescriptor_t s_tx_tail;
+
+/* Buffers the DMAC reads/writes after Transfer() has returned */
+static uint8_t s_cmd[QSPI_SPI_DMA_CMD_MAX];
+static uint8_t s_tx_fill = QSPI_SPI_DMA_TX_FILL;
+static uint8_t s_rx_discard;
+
+static volatile bool s_busy = false;
+static volatile bool s_ok = false;
+static QSPI_SPI_DMA_Callback_t s_cb = NULL;
+
+static void qspi_spi_dma_abort(void);
+
+static void qspi_dma_channel_config(uint8_t channel, uint8_t trigsrc, uint8_t prilvl, bool irq)
+{
+    DMAC_REGS->CHANNEL[channel].DMAC_CHCTRLA &= ~DMAC_CHCTRLA_ENABLE_Msk;
+    while ((DMAC_REGS->CHANNEL[channel].DMAC_CHCTRLA & DMAC_CHCTRLA_ENABLE_Msk) != 0U) { }
+
+    /* One beat per peripheral trigger (same as the UART2 TX channel) */
+    DMAC_REGS->CHANNEL[channel].DMAC_CHCTRLA =
+        DMAC_CHCTRLA_TRIGACT_BURST |
+        DMAC_CHCTRLA_TRIGSRC(trigsrc) |
+        DMAC_CHCTRLA_THRESHOLD(0U) |
+        DMAC_CHCTRLA_BURSTLEN(0U);
+
+    DMAC_REGS->CHANNEL[channel].DMAC_CHPRILVL = DMAC_CHPRILVL_PRILVL(prilvl);
+
+    DMAC_REGS->CHANNEL[channel].DMAC_CHINTENCLR =
+        (DMAC_CHINTENCLR_TCMPL_Msk | DMAC_CHINTENCLR_TERR_Msk | DMAC_CHINTENCLR_SUSP_Msk);
+    if (irq)
+    {
+        DMAC_REGS->CHANNEL[channel].DMAC_CHINTENSET =
+            (DMAC_CHINTENSET_TCMPL_Msk | DMAC_CHINTENSET_TERR_Msk);
+    }
+
+    DMAC_REGS->CHANNEL[channel].DMAC_CHINTFLAG =
+        (DMAC_CHINTFLAG_TCMPL_Msk | DMAC_CHINTFLAG_TERR_Msk | DMAC_CHINTFLAG_SUSP_Msk);
+}
+
+/* Fill one descriptor. Incrementing addresses point at the END of the block. */
+static void qspi_dma_desc(DmacDescriptor_t *d,
+                          uint32_t src, bool srcinc,
+                          uint32_t dst, bool dstinc,
+                          uint16_t count,
+                          const DmacDescriptor_t *next)
+{
+    d->btctrl = (uint16_t)(DMAC_BTCTRL_VALID_Msk |
+                           DMAC_BTCTRL_BEATSIZE_BYTE |
+                           (srcinc ? DMAC_BTCTRL_SRCINC_Msk : 0U) |
+                           (dstinc ? DMAC_BTCTRL_DSTINC_Msk : 0U) |
+                           ((next == NULL) ? DMAC_BTCTRL_BLOCKACT_INT : DMAC_BTCTRL_BLOCKACT_NOACT));
+    d->btcnt    = count;
+    d->srcaddr  = srcinc ? (src + count) : src;
+    d->dstaddr  = dstinc ? (dst + count) : dst;
+    d->descaddr = (uint32_t)next;
+}
+
+void QSPI_SPI_DMA_Init(void)
+{
+    qspi_dma_channel_config(QSPI_SPI_DMA_RX_CHANNEL, QSPI_DMAC_ID_RX, QSPI_SPI_DMA_RX_PRILVL, true);
+    qspi_dma_channel_config(QSPI_SPI_DMA_TX_CHANNEL, QSPI_DMAC_ID_TX, QSPI_SPI_DMA_TX_PRILVL, false);
+
+    s_busy = false;
+
+    NVIC_ClearPendingIRQ(DMAC_1_IRQn);
+    NVIC_EnableIRQ(DMAC_1_IRQn);
+}
+
+bool QSPI_SPI_DMA_Transfer(const void *cmd, uint16_t cmd_len,
+                           const void *tx, void *rx, uint16_t len,
+                           QSPI_SPI_DMA_Callback_t cb)
+{
+    if ((len == 0U) || (cmd_len > QSPI_SPI_DMA_CMD_MAX) ||
+        ((cmd_len != 0U) && (cmd == NULL)))
+    {
+        return false;
+    }
+
+    if (s_busy)
+    {
+        return false;
+    }
+
+    DmacDescriptor_t *rx_base = DMA_GetDescriptor(QSPI_SPI_DMA_RX_CHANNEL);
+    DmacDescriptor_t *tx_base = DMA_GetDescriptor(QSPI_SPI_DMA_TX_CHANNEL);
+    if ((rx_base == NULL) || (tx_base == NULL))
+    {
+        return false;
+    }
+
+    s_busy = true;
+    s_ok   = false;
+    s_cb   = cb;
+
+    const uint32_t rxdata = (uint32_t)&QSPI_REGS->QSPI_RXDATA;
+    const uint32_t txdata = (uint32_t)&QSPI_REGS->QSPI_TXDATA;
+
+    const uint32_t rx_dst = (rx != NULL) ? (uint32_t)rx : (uint32_t)&s_rx_discard;
+    const uint32_t tx_src = (tx != NULL) ? (uint32_t)tx : (uint32_t)&s_tx_fill;
+
+    if (cmd_len != 0U)
+    {
+        memcpy(s_cmd, cmd, cmd_len);
+
+        qspi_dma_desc(rx_base, rxdata, false, (uint32_t)&s_rx_discard, false, cmd_len, &s_rx_tail);
+        qspi_dma_desc(&s_rx_tail, rxdata, false, rx_dst, (rx != NULL), len, NULL);
+
+        qspi_dma_desc(tx_base, (uint32_t)s_cmd, true, txdata, false, cmd_len, &s_tx_tail);
+        qspi_dma_desc(&s_tx_tail, tx_src, (tx != NULL), txdata, false, len, NULL);
+    }
+    else
+    {
+        qspi_dma_desc(rx_base, rxdata, false, rx_dst, (rx != NULL), len, NULL);
+        qspi_dma_desc(tx_base, tx_src, (tx != NULL), txdata, false, len, NULL);
+    }
+
+    /* TX ends before RX (its TCMPL IRQ is not enabled); RX TCMPL ends the transfer */
+    QSPI_HW_SetSpiMode(true);
+
+    /* Drop any stale RX character so the first RXC belongs to this transfer */
+    (void)QSPI_REGS->QSPI_RXDATA;
+
+    DMAC_REGS->CHANNEL[QSPI_SPI_DMA_RX_CHANNEL].DMAC_CHINTFLAG =
+        (DMAC_CHINTFLAG_TCMPL_Msk | DMAC_CHINTFLAG_TERR_Msk);
+    DMAC_REGS->CHANNEL[QSPI_SPI_DMA_TX_CHANNEL].DMAC_CHINTFLAG =
+        (DMAC_CHINTFLAG_TCMPL_Msk | DMAC_CHINTFLAG_TERR_Msk);
+
+    /* RX armed first; enabling TX starts the clock (DRE is already set) */
+    DMAC_REGS->CHANNEL[QSPI_SPI_DMA_RX_CHANNEL].DMAC_CHCTRLA |= DMAC_CHCTRLA_ENABLE_Msk;
+    DMAC_REGS->CHANNEL[QSPI_SPI_DMA_TX_CHANNEL].DMAC_CHCTRLA |= DMAC_CHCTRLA_ENABLE_Msk;
+
+    return true;
+}
+
+bool QSPI_SPI_DMA_IsBusy(void)
+{
+    return s_busy;
+}
+
+bool QSPI_SPI_DMA_Wait(uint32_t timeout_ms)
+{
+    uint32_t t0 = millis();
+    while (s_busy)
+    {
+        if ((millis() - t0) >= timeout_ms)
+        {
+            qspi_spi_dma_abort();
+            return false;
+        }
+    }
+    return s_ok;
+}
+
+/* End of transfer: release CS, go back to serial-memory mode, notify. */
+static void qspi_spi_dma_finish(bool ok)
+{
+    DMAC_REGS->CHANNEL[QSPI_SPI_DMA_TX_CHANNEL].DMAC_CHCTRLA &= ~DMAC_CHCTRLA_ENABLE_Msk;
+
+    QSPI_REGS->QSPI_CTRLA = QSPI_CTRLA_ENABLE_Msk | QSPI_CTRLA_LASTXFER_Msk;
+    QSPI_HW_SetSpiMode(false);
+
+    s_ok   = ok;
+    s_busy = false;
+
+    if (s_cb != NULL)
+    {
+        s_cb(ok);
+    }
+}
+
+/* Timed out: stop both channels and end the transfer as failed, so the
+ * QSPI is not left in SPI mode with CS held */
+static void qspi_spi_dma_abort(void)
+{
+    NVIC_DisableIRQ(DMAC_1_IRQn);
+
+    DMAC_REGS->CHANNEL[QSPI_SPI_DMA_RX_CHANNEL].DMAC_CHCTRLA &= ~DMAC_CHCTRLA_ENABLE_Msk;
+    DMAC_REGS->CHANNEL[QSPI_SPI_DMA_TX_CHANNEL].DMAC_CHCTRLA &= ~DMAC_CHCTRLA_ENABLE_Msk;
+    while ((DMAC_REGS->CHANNEL[QSPI_SPI_DMA_RX_CHANNEL].DMAC_CHCTRLA & DMAC_CHCTRLA_ENABLE_Msk) != 0U) { }
+    while ((DMAC_REGS->CHANNEL[QSPI_SPI_DMA_TX_CHANNEL].DMAC_CHCTRLA & DMAC_CHCTRLA_ENABLE_Msk) != 0U) { }
+
+    DMAC_REGS->CHANNEL[QSPI_SPI_DMA_RX_CHANNEL].DMAC_CHINTFLAG =
+        (DMAC_CHINTFLAG_TCMPL_Msk | DMAC_CHINTFLAG_TERR_Msk);
+    NVIC_ClearPendingIRQ(DMAC_1_IRQn);
+
+    /* the completion IRQ may have won the race */
+    if (s_busy)
+    {
+        qspi_spi_dma_finish(false);
+    }
+
+    NVIC_EnableIRQ(DMAC_1_IRQn);
+}
+
+/**
+ * DMA Channel 1 Interrupt Handler (QSPI SPI-mode RX).
+ */
+void DMAC_1_Handler(void)
+{
+    uint8_t channel = QSPI_SPI_DMA_RX_CHANNEL;
+    uint8_t flags = DMAC_REGS->CHANNEL[channel].DMAC_CHINTFLAG;
+
+    if ((flags & DMAC_CHINTFLAG_TERR_Msk) != 0U)
+    {
+        DMAC_REGS->CHANNEL[channel].DMAC_CHINTFLAG = DMAC_CHINTFLAG_TERR_Msk;
+        qspi_spi_dma_finish(false);
+        return;
+    }
+
+    if ((flags & DMAC_CHINTFLAG_TCMPL_Msk) != 0U)
+    {
+        DMAC_REGS->CHANNEL[channel].DMAC_CHINTFLAG = DMAC_CHINTFLAG_TCMPL_Msk;
+        qspi_spi_dma_finish(true);
+    }
+}
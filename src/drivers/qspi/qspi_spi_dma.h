@@ -0,0 +1,69 @@
+/* qspi_spi_dma.h: QSPI SPI-mode streaming with DMAC TX/RX triggers
+ *
+ * For long non-memory transfers (SFDP dumps, bulk register reads, generic SPI
+ * devices on the QSPI pins). The QSPI is switched to CTRLB.MODE=SPI and two
+ * DMAC channels move the bytes: TX paced by QSPI_DMAC_ID_TX (DRE) feeds
+ * TXDATA, RX paced by QSPI_DMAC_ID_RX (RXC) drains RXDATA. The CPU only
+ * starts the transfer; the RX completion IRQ ends it (LASTXFER) and puts the
+ * QSPI back into serial-memory mode.
+ *
+ * SPI mode is 1-bit (DATA0 = MOSI, DATA1 = MISO): the flash must be in its
+ * single-bit protocol, not SQI/QPI, while a transfer runs.
+ *
+ * The transfer owns the QSPI: until it ends, memory-mode accesses (object
+ * store, job engine, cache fills) are refused by qspi_hw.c, so they fail
+ * instead of corrupting it. A transfer that times out in QSPI_SPI_DMA_Wait()
+ * is aborted and the QSPI returned to memory mode.
+ */
+
+#ifndef QSPI_SPI_DMA_H
+#define QSPI_SPI_DMA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "qspi_hw.h"
+
+/* DMAC channels (channel 0 is UART2 TX). Channels 1..3 have their own IRQ. */
+#define QSPI_SPI_DMA_RX_CHANNEL     1
+#define QSPI_SPI_DMA_TX_CHANNEL     2
+
+/* RX above TX so RXDATA never overruns while TX keeps DRE busy */
+#define QSPI_SPI_DMA_RX_PRILVL      2U
+#define QSPI_SPI_DMA_TX_PRILVL      1U
+
+/* Fill byte clocked out while only receiving */
+#define QSPI_SPI_DMA_TX_FILL        (0xFFU)
+
+typedef void (*QSPI_SPI_DMA_Callback_t)(bool ok);
+
+/**
+ * Configure both DMAC channels. Must be called after UART2_DMA_Init()
+ * (which enables the DMAC and owns the descriptor tables).
+ */
+void QSPI_SPI_DMA_Init(void);
+
+/**
+ * Start a full-duplex SPI transfer and return immediately.
+ *
+ * cmd/cmd_len: header (opcode, address, dummy bytes) sent first; the bytes
+ *              received during the header are discarded. cmd_len may be 0.
+ * tx:          payload to send, or NULL to clock out QSPI_SPI_DMA_TX_FILL
+ * rx:          payload destination, or NULL to discard
+ * len:         payload length (1..65535, DMAC BTCNT is 16-bit)
+ * cb:          optional, called from the DMAC IRQ when the transfer ends
+ *
+ * Returns false if a transfer is already running or arguments are invalid.
+ */
+bool QSPI_SPI_DMA_Transfer(const void *cmd, uint16_t cmd_len,
+                           const void *tx, void *rx, uint16_t len,
+                           QSPI_SPI_DMA_Callback_t cb);
+
+bool QSPI_SPI_DMA_IsBusy(void);
+
+/* Blocking helper: wait for the running transfer, true if it completed OK.
+ * On timeout the transfer is aborted (cb, if any, gets false). */
+bool QSPI_SPI_DMA_Wait(uint32_t timeout_ms);
+
+#endif /* QSPI_SPI_DMA_H */
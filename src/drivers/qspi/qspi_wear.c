@@ -0,0 +1,511 @@
+/* qspi_wear.c: Per-sector erase counters and wear histogram */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include "../../common/systick.h"
+#include "qspi_wear.h"
+#include "qspi_flash.h"
+#include "qspi_job.h"
+#include "qspi_crc32.h"
+#include "qspi_crc_hw.h"
+
+#if QSPI_WEAR_ENABLE
+
+#define WEAR_HDR_MAGIC      (0x31524557UL)  /* 'WER1' */
+#define WEAR_LOG_MAGIC      (0x314C5757UL)  /* 'WWL1' */
+#define WEAR_ERASED_WORD    (0xFFFFFFFFUL)
+#define WEAR_COUNT_MAX      (0xFFFFU)
+#define WEAR_READ_CHUNK     (1024U)
+
+/* Region header, first bytes of the region's first page */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t seq;           /* higher = newer; the newer valid region wins */
+    uint32_t sectors;
+    uint32_t table_crc;     /* snapshot behind this page */
+    uint32_t hdr_crc;       /* over the fields above */
+} wear_hdr_t;
+
+typedef struct
+{
+    uint16_t sector;
+    uint16_t delta;
+} wear_rec_t;
+
+#define WEAR_LOG_HDR_SIZE   (16U)
+#define WEAR_LOG_RECS       ((QSPI_WEAR_PAGE_SIZE - WEAR_LOG_HDR_SIZE) / sizeof(wear_rec_t))
+
+/* One log page; only the header and n records are programmed */
+typedef struct
+{
+    uint32_t   magic;
+    uint32_t   seq;         /* region seq it belongs to */
+    uint16_t   n;
+    uint16_t   reserved;
+    uint32_t   crc;         /* over rec[0..n) */
+    wear_rec_t rec[WEAR_LOG_RECS];
+} wear_log_page_t;
+
+_Static_assert(sizeof(wear_log_page_t) == QSPI_WEAR_PAGE_SIZE, "log page layout");
+
+static uint16_t s_counts[QSPI_WEAR_MAX_SECTORS];
+static uint32_t s_nsect;
+
+/* Layout */
+static uint32_t s_area_base;
+static uint32_t s_region_size;
+static uint32_t s_log_off;          /* log start inside a region */
+static uint32_t s_log_pages;
+
+/* Mounted state */
+static bool     s_ready;
+static int      s_active;           /* region holding the live snapshot, -1 = none */
+static uint32_t s_seq;
+static uint32_t s_log_next;         /* next free log page */
+
+/* Batching */
+static wear_log_page_t s_batch;     /* collecting */
+static wear_log_page_t s_out;       /* being programmed */
+static uint32_t s_batch_t0;
+static bool     s_need_snap;        /* RAM holds counts the log cannot carry */
+static bool     s_busy;             /* own job queued */
+static bool     s_retry;
+static uint32_t s_retry_t0;
+static int      s_snap_target;
+static wear_hdr_t s_hdr;
+static uint32_t s_snapshots;
+static uint32_t s_log_writes;
+
+static inline uint32_t wear_region_base(int r)
+{
+    return s_area_base + ((uint32_t)r * s_region_size);
+}
+
+static inline uint32_t wear_round_up(uint32_t v, uint32_t a)
+{
+    return (v + (a - 1U)) & ~(a - 1U);
+}
+
+static bool wear_ranges_overlap(uint32_t a, uint32_t alen, uint32_t b, uint32_t blen)
+{
+    return (alen != 0U) && (blen != 0U) && (a < (b + blen)) && (b < (a + alen));
+}
+
+static uint32_t wear_hdr_crc(const wear_hdr_t *h)
+{
+    return QSPI_CRC32(h, offsetof(wear_hdr_t, hdr_crc));
+}
+
+static bool wear_read(const qspi_flash_ops_t *ops, void *dst, uint32_t len, uint32_t addr)
+{
+    uint8_t *p = (uint8_t *)dst;
+
+    while (len != 0U)
+    {
+        uint32_t n = (len > WEAR_READ_CHUNK) ? WEAR_READ_CHUNK : len;
+        if (!ops->read(p, n, addr))
+            return false;
+        p += n;
+        addr += n;
+        len -= n;
+    }
+    return true;
+}
+
+static void wear_add(uint32_t sector, uint32_t delta)
+{
+    uint32_t c = (uint32_t)s_counts[sector] + delta;
+    s_counts[sector] = (uint16_t)((c > WEAR_COUNT_MAX) ? WEAR_COUNT_MAX : c);
+}
+
+/* Load the snapshot of region r and replay its log */
+static bool wear_mount_region(const qspi_flash_ops_t *ops, int r, const wear_hdr_t *h)
+{
+    const uint32_t base = wear_region_base(r);
+
+    if (!wear_read(ops, s_counts, s_nsect * sizeof(s_counts[0]), base + QSPI_WEAR_PAGE_SIZE) ||
+        (QSPI_CRC_HW_Buffer(s_counts, s_nsect * sizeof(s_counts[0])) != h->table_crc))
+        return false;
+
+    s_active   = r;
+    s_seq      = h->seq;
+    s_log_next = 0U;
+
+    for (uint32_t p = 0; p < s_log_pages; p++)
+    {
+        wear_log_page_t *pg = &s_out;
+        if (!ops->read(pg, QSPI_WEAR_PAGE_SIZE, base + s_log_off + (p * QSPI_WEAR_PAGE_SIZE)))
+            return false;
+        if (pg->magic == WEAR_ERASED_WORD)
+            break;
+
+        s_log_next = p + 1U;
+        /* torn or foreign page: skip it, the page is used up either way */
+        if ((pg->magic != WEAR_LOG_MAGIC) || (pg->seq != s_seq) || (pg->n > WEAR_LOG_RECS) ||
+            (QSPI_CRC32(pg->rec, pg->n * sizeof(wear_rec_t)) != pg->crc))
+            continue;
+
+        for (uint32_t i = 0; i < pg->n; i++)
+        {
+            if (pg->rec[i].sector < s_nsect)
+                wear_add(pg->rec[i].sector, pg->rec[i].delta);
+        }
+    }
+    return true;
+}
+
+bool QSPI_Wear_Init(void)
+{
+    const qspi_flash_ops_t *ops = QSPI_Flash_Ops();
+    wear_hdr_t h[2];
+    bool valid[2];
+
+    s_ready = false;
+    if (ops == NULL)
+        return false;
+
+    s_nsect = ops->capacity / QSPI_WEAR_SECTOR_SIZE;
+    if (s_nsect > QSPI_WEAR_MAX_SECTORS)
+    {
+        printf("[QSPI_WEAR] only the first %u sectors are tracked\r\n",
+               (unsigned)QSPI_WEAR_MAX_SECTORS);
+        s_nsect = QSPI_WEAR_MAX_SECTORS;
+    }
+
+    uint32_t align = (ops->sector_size > QSPI_WEAR_SECTOR_SIZE) ? ops->sector_size
+                                                                : QSPI_WEAR_SECTOR_SIZE;
+    s_log_off     = wear_round_up(QSPI_WEAR_PAGE_SIZE + (s_nsect * sizeof(s_counts[0])),
+                                  QSPI_WEAR_PAGE_SIZE);
+    s_region_size = wear_round_up(s_log_off + QSPI_WEAR_LOG_SIZE, align);
+    s_log_pages   = (s_region_size - s_log_off) / QSPI_WEAR_PAGE_SIZE;
+    if ((2U * s_region_size) >= (ops->capacity / 2U))
+    {
+        printf("[QSPI_WEAR] flash too small for the wear area\r\n");
+        return false;
+    }
+    s_area_base = ops->capacity - (2U * s_region_size);
+
+    for (int r = 0; r < 2; r++)
+    {
+        valid[r] = ops->read(&h[r], sizeof(h[r]), wear_region_base(r)) &&
+                   (h[r].magic == WEAR_HDR_MAGIC) &&
+                   (h[r].sectors == s_nsect) &&
+                   (wear_hdr_crc(&h[r]) == h[r].hdr_crc);
+    }
+
+    /* newest first; an older region is the fallback for a torn snapshot */
+    int first = (valid[1] && (!valid[0] || ((int32_t)(h[1].seq - h[0].seq) > 0))) ? 1 : 0;
+    bool mounted = false;
+    for (int k = 0; (k < 2) && !mounted; k++)
+    {
+        int r = (k == 0) ? first : (1 - first);
+        if (valid[r])
+            mounted = wear_mount_region(ops, r, &h[r]);
+    }
+
+    if (!mounted)
+    {
+        memset(s_counts, 0, sizeof(s_counts));
+        s_active    = -1;
+        s_seq       = 0U;
+        s_log_next  = 0U;
+        s_need_snap = true;
+        printf("[QSPI_WEAR] no counters found, starting from zero\r\n");
+    }
+    else
+    {
+        s_need_snap = false;
+        printf("[QSPI_WEAR] region %d seq %lu, %lu/%lu log pages used\r\n",
+               s_active, (unsigned long)s_seq,
+               (unsigned long)s_log_next, (unsigned long)s_log_pages);
+    }
+
+    s_batch.n = 0U;
+    s_busy    = false;
+    s_retry   = false;
+    s_ready   = true;
+    return true;
+}
+
+static void wear_batch_add(uint32_t sector)
+{
+    for (uint32_t i = 0; i < s_batch.n; i++)
+    {
+        if (s_batch.rec[i].sector == sector)
+        {
+            if (s_batch.rec[i].delta != WEAR_COUNT_MAX)
+                s_batch.rec[i].delta++;
+            return;
+        }
+    }
+
+    if (s_batch.n >= WEAR_LOG_RECS)
+    {
+        /* more distinct sectors than a page holds: the snapshot carries them */
+        s_need_snap = true;
+        return;
+    }
+    if (s_batch.n == 0U)
+        s_batch_t0 = millis();
+    s_batch.rec[s_batch.n].sector = (uint16_t)sector;
+    s_batch.rec[s_batch.n].delta  = 1U;
+    s_batch.n++;
+}
+
+void QSPI_Wear_NoteErase(uint32_t addr, uint32_t len)
+{
+    if (!s_ready || (len == 0U))
+        return;
+
+    uint32_t first = addr / QSPI_WEAR_SECTOR_SIZE;
+    uint32_t last  = (addr + len + (QSPI_WEAR_SECTOR_SIZE - 1U)) / QSPI_WEAR_SECTOR_SIZE;
+    if (last > s_nsect)
+        last = s_nsect;
+
+    for (uint32_t s = first; s < last; s++)
+    {
+        if (s_counts[s] != WEAR_COUNT_MAX)
+            s_counts[s]++;
+        if (!s_need_snap)
+            wear_batch_add(s);
+    }
+
+    /* chip erase (or anything else) wiped the live region */
+    if ((s_active >= 0) &&
+        wear_ranges_overlap(addr, len, wear_region_base(s_active), s_region_size))
+    {
+        s_active    = -1;
+        s_need_snap = true;
+    }
+}
+
+static void wear_fail(const char *what)
+{
+    printf("[QSPI_WEAR] %s failed, retry in %lu ms\r\n", what, (unsigned long)QSPI_WEAR_FLUSH_MS);
+    s_busy      = false;
+    s_need_snap = true;
+    s_retry     = true;
+    s_retry_t0  = millis();
+}
+
+static void wear_log_done(bool ok, void *ctx)
+{
+    (void)ctx;
+    s_busy = false;
+    s_log_next++;           /* a failed page is skipped on mount */
+    if (ok)
+        s_log_writes++;
+    else
+        wear_fail("log write");
+}
+
+static void wear_log_start(void)
+{
+    s_out       = s_batch;
+    s_out.magic = WEAR_LOG_MAGIC;
+    s_out.seq   = s_seq;
+    s_out.reserved = 0xFFFFU;
+    s_out.crc   = QSPI_CRC32(s_out.rec, s_out.n * sizeof(wear_rec_t));
+    s_batch.n   = 0U;
+
+    const qspi_job_seg_t seg =
+    {
+        wear_region_base(s_active) + s_log_off + (s_log_next * QSPI_WEAR_PAGE_SIZE),
+        &s_out,
+        WEAR_LOG_HDR_SIZE + ((uint32_t)s_out.n * sizeof(wear_rec_t))
+    };
+
+    s_busy = true;
+    if (!QSPI_Job_Write(0U, 0U, &seg, 1U, true, wear_log_done, NULL))
+        wear_fail("log write");
+}
+
+static void wear_snap_done(bool ok, void *ctx)
+{
+    (void)ctx;
+    if (!ok)
+    {
+        wear_fail("snapshot");
+        return;
+    }
+    s_busy      = false;
+    s_active    = s_snap_target;
+    s_seq       = s_hdr.seq;
+    s_log_next  = 0U;
+    s_need_snap = false;
+    s_retry     = false;
+    s_snapshots++;
+}
+
+/* Target region erased: program header + counters. Nothing erases between
+ * here and the end of the job, so the table CRC stays valid. */
+static void wear_snap_erased(bool ok, void *ctx)
+{
+    (void)ctx;
+    if (!ok)
+    {
+        wear_fail("snapshot erase");
+        return;
+    }
+
+    const uint32_t base = wear_region_base(s_snap_target);
+    const uint32_t table_len = s_nsect * sizeof(s_counts[0]);
+
+    s_batch.n       = 0U;
+    s_hdr.magic     = WEAR_HDR_MAGIC;
+    s_hdr.seq       = s_seq + 1U;
+    s_hdr.sectors   = s_nsect;
+    s_hdr.table_crc = QSPI_CRC_HW_Buffer(s_counts, table_len);
+    s_hdr.hdr_crc   = wear_hdr_crc(&s_hdr);
+
+    const qspi_job_seg_t segs[2] =
+    {
+        { base,                          &s_hdr,   (uint32_t)sizeof(s_hdr) },
+        { base + QSPI_WEAR_PAGE_SIZE,    s_counts, table_len },
+    };
+
+    if (!QSPI_Job_Write(0U, 0U, segs, 2U, true, wear_snap_done, NULL))
+        wear_fail("snapshot");
+}
+
+static void wear_snap_start(void)
+{
+    s_snap_target = (s_active == 0) ? 1 : 0;
+    s_busy = true;
+    if (!QSPI_Job_Write(wear_region_base(s_snap_target), s_region_size, NULL, 0U, false,
+                        wear_snap_erased, NULL))
+        wear_fail("snapshot erase");
+}
+
+void QSPI_Wear_Task(void)
+{
+    if (!s_ready || s_busy || QSPI_Job_IsBusy())
+        return;
+
+    if (s_need_snap)
+    {
+        if (!s_retry || ((millis() - s_retry_t0) >= QSPI_WEAR_FLUSH_MS))
+            wear_snap_start();
+        return;
+    }
+
+    if (s_batch.n == 0U)
+        return;
+    if ((s_batch.n < WEAR_LOG_RECS) && ((millis() - s_batch_t0) < QSPI_WEAR_FLUSH_MS))
+        return;
+
+    if (s_log_next >= s_log_pages)
+    {
+        s_need_snap = true;     /* log full: compact into the other region */
+        wear_snap_start();
+        return;
+    }
+    wear_log_start();
+}
+
+uint16_t QSPI_Wear_Count(uint32_t addr)
+{
+    uint32_t s = addr / QSPI_WEAR_SECTOR_SIZE;
+    return (s_ready && (s < s_nsect)) ? s_counts[s] : 0U;
+}
+
+bool QSPI_Wear_Overlaps(uint32_t addr, uint32_t len)
+{
+    return s_ready && wear_ranges_overlap(addr, len, s_area_base, 2U * s_region_size);
+}
+
+void QSPI_Wear_GetSummary(qspi_wear_summary_t *out)
+{
+    if (out == NULL)
+        return;
+
+    memset(out, 0, sizeof(*out));
+    if (!s_ready)
+        return;
+
+    out->sectors = s_nsect;
+    out->min = WEAR_COUNT_MAX;
+    for (uint32_t s = 0; s < s_nsect; s++)
+    {
+        uint16_t c = s_counts[s];
+        out->total += c;
+        if (c < out->min)
+            out->min = c;
+        if (c > out->max)
+            out->max = c;
+
+        uint32_t bin = (c == 0U) ? 0U : (32U - (uint32_t)__builtin_clz(c));
+        if (bin >= QSPI_WEAR_HIST_BINS)
+            bin = QSPI_WEAR_HIST_BINS - 1U;
+        out->hist[bin]++;
+
+        /* keep the hottest few, sorted */
+        if ((c == 0U) || (c <= out->hot_count[QSPI_WEAR_HOT_COUNT - 1U]))
+            continue;
+        uint32_t i = QSPI_WEAR_HOT_COUNT - 1U;
+        while ((i > 0U) && (c > out->hot_count[i - 1U]))
+        {
+            out->hot_count[i]  = out->hot_count[i - 1U];
+            out->hot_sector[i] = out->hot_sector[i - 1U];
+            i--;
+        }
+        out->hot_count[i]  = c;
+        out->hot_sector[i] = s;
+    }
+}
+
+void QSPI_Wear_Print(void)
+{
+    qspi_wear_summary_t ws;
+
+    printf("---- Erase wear ----\r\n");
+    if (!s_ready)
+    {
+        printf("  Counters      : OFF\r\n");
+        return;
+    }
+
+    QSPI_Wear_GetSummary(&ws);
+    printf("  Area          : 0x%06lX..0x%06lX, region %d seq %lu, log %lu/%lu pages\r\n",
+           (unsigned long)s_area_base,
+           (unsigned long)(s_area_base + (2U * s_region_size) - 1U),
+           s_active, (unsigned long)s_seq,
+           (unsigned long)s_log_next, (unsigned long)s_log_pages);
+    printf("  Bookkeeping   : %lu log pages, %lu snapshots, %u pending%s\r\n",
+           (unsigned long)s_log_writes, (unsigned long)s_snapshots,
+           (unsigned)s_batch.n, s_need_snap ? " (snapshot due)" : "");
+    printf("  Erases        : %lu over %lu sectors (min %u, max %u)\r\n",
+           (unsigned long)ws.total, (unsigned long)ws.sectors,
+           (unsigned)ws.min, (unsigned)ws.max);
+
+    for (uint32_t b = 0; b < QSPI_WEAR_HIST_BINS; b++)
+    {
+        if (ws.hist[b] == 0U)
+            continue;
+        if (b == 0U)
+            printf("  %13s : %lu sectors\r\n", "0", (unsigned long)ws.hist[b]);
+        else if (b == (QSPI_WEAR_HIST_BINS - 1U))
+            printf("  %12lu+ : %lu sectors\r\n",
+                   (unsigned long)(1UL << (b - 1U)), (unsigned long)ws.hist[b]);
+        else
+            printf("  %6lu-%-6lu : %lu sectors\r\n",
+                   (unsigned long)(1UL << (b - 1U)), (unsigned long)((1UL << b) - 1UL),
+                   (unsigned long)ws.hist[b]);
+    }
+
+    if (ws.hot_count[0] != 0U)
+    {
+        printf("  Hottest       :");
+        for (uint32_t i = 0; (i < QSPI_WEAR_HOT_COUNT) && (ws.hot_count[i] != 0U); i++)
+        {
+            printf(" 0x%06lX=%u",
+                   (unsigned long)(ws.hot_sector[i] * QSPI_WEAR_SECTOR_SIZE),
+                   (unsigned)ws.hot_count[i]);
+        }
+        printf("\r\n");
+    }
+}
+
+#endif /* QSPI_WEAR_ENABLE */
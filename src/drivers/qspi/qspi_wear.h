@@ -0,0 +1,74 @@
+/* qspi_wear.h: Per-sector erase counters and wear histogram
+ *
+ * Every erase that completes in the job engine (QSPI_Job_Write,
+ * QSPI_Job_ChipErase, so every QSPI_Flash_* write) bumps a RAM counter for
+ * each 4 KB sector it covered. The counters persist in a metadata area at
+ * the top of the flash, reserved from QSPI_Flash_* writes:
+ *
+ *   two regions, used in turn:  [header page][snapshot: u16 per sector][log]
+ *
+ * Updates are batched so the bookkeeping does not add erases of its own:
+ * increments collect in a RAM page of {sector, delta} records (repeated
+ * erases of one sector share a record), and the page is appended to the log
+ * of the active region (one page program) when it is full or
+ * QSPI_WEAR_FLUSH_MS after its first record. Only a full log (or a chip
+ * erase) writes a new snapshot into the other region, which costs one
+ * region erase per QSPI_WEAR_LOG_SIZE / 256 log pages.
+ *
+ * Erases issued straight through a driver (SST26 full-chip test, image
+ * programming, benchmark) bypass the job engine and are not counted.
+ * Counters saturate at 65535.
+ */
+
+#ifndef QSPI_WEAR_H
+#define QSPI_WEAR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* 1 = track erase counts (reserves the metadata area at the top of flash) */
+#ifndef QSPI_WEAR_ENABLE
+#define QSPI_WEAR_ENABLE        1
+#endif
+
+#define QSPI_WEAR_SECTOR_SIZE   (4096UL)
+#define QSPI_WEAR_MAX_SECTORS   (8192U)     /* 32 MB; 16 KB of RAM */
+#define QSPI_WEAR_PAGE_SIZE     (256U)      /* log record page */
+#define QSPI_WEAR_LOG_SIZE      (8192UL)    /* per region */
+#ifndef QSPI_WEAR_FLUSH_MS
+#define QSPI_WEAR_FLUSH_MS      (5000UL)
+#endif
+
+/* Histogram bins: 0, 1, 2-3, 4-7, ... 2^14+ */
+#define QSPI_WEAR_HIST_BINS     (16U)
+#define QSPI_WEAR_HOT_COUNT     (5U)
+
+typedef struct
+{
+    uint32_t sectors;                       /* tracked */
+    uint32_t total;                         /* erases over all sectors */
+    uint16_t min;
+    uint16_t max;
+    uint32_t hist[QSPI_WEAR_HIST_BINS];
+    uint32_t hot_sector[QSPI_WEAR_HOT_COUNT];   /* most erased first */
+    uint16_t hot_count[QSPI_WEAR_HOT_COUNT];
+} qspi_wear_summary_t;
+
+/* Mount the metadata area (or start fresh). Called by QSPI_Flash_Init(). */
+bool QSPI_Wear_Init(void);
+
+/* Job engine hook: [addr, addr + len) was erased */
+void QSPI_Wear_NoteErase(uint32_t addr, uint32_t len);
+
+/* Superloop: writes batched updates once the job engine is idle */
+void QSPI_Wear_Task(void);
+
+uint16_t QSPI_Wear_Count(uint32_t addr);
+
+/* True if the range touches the metadata area (QSPI_Flash_* refuse it) */
+bool QSPI_Wear_Overlaps(uint32_t addr, uint32_t len);
+
+void QSPI_Wear_GetSummary(qspi_wear_summary_t *out);
+void QSPI_Wear_Print(void);
+
+#endif /* QSPI_WEAR_H */
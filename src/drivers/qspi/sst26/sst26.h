@@ -9,6 +9,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "../qspi_hw.h"
+#include "../qspi_flash_ops.h"
 
 /* Harmony app_sst26.h command set */
 #define SST26_CMD_FLASH_RESET_ENABLE     (0x66U)
@@ -21,19 +22,45 @@
 #define SST26_CMD_QUAD_JEDEC_ID_READ     (0xAFU)
 
 #define SST26_CMD_HIGH_SPEED_READ        (0x0BU)
+
+/* SPI-protocol reads (flash out of SQI, see SST26_DisableQuadIO).
+ * 6Bh/EBh need SST26_CR_IOC_Msk so WP#/HOLD# become SIO2/SIO3. */
+#define SST26_CMD_READ                   (0x03U)    /* 1-1-1, no dummy              */
+#define SST26_CMD_SDOR                   (0x3BU)    /* 1-1-2, 8 dummy               */
+#define SST26_CMD_SDIOR                  (0xBBU)    /* 1-2-2, mode byte (4 clk)     */
+#define SST26_CMD_SQOR                   (0x6BU)    /* 1-1-4, 8 dummy               */
+#define SST26_CMD_SQIOR                  (0xEBU)    /* 1-4-4, mode (2 clk) + 4 dummy */
+#define SST26_SPI_READ_DUMMY_CYCLES      (8U)
+#define SST26_SQIOR_DUMMY_CYCLES         (4U)
+
+#define SST26_CMD_READ_CONFIG_REG        (0x35U)
+#define SST26_CMD_WRITE_STATUS_REG       (0x01U)    /* status + config byte */
+#define SST26_CR_IOC_Msk                 (1U << 1)
+
+/* SQI High-Speed Read: address, mode byte M[7:0] (2 clk), 2 dummy bytes (4 clk).
+ * M[7:4]=0xA keeps the read latched, so following reads skip the opcode. */
+#define SST26_HSREAD_DUMMY_CYCLES        (6U)
+#define SST26_HSREAD_MODE_CONTINUOUS     (0xA0U)
+#define SST26_HSREAD_MODE_EXIT           (0xFFU)
 #define SST26_CMD_WRITE_ENABLE           (0x06U)
 #define SST26_CMD_PAGE_PROGRAM           (0x02U)
 
 #define SST26_CMD_READ_STATUS_REG        (0x05U)
 
 #define SST26_CMD_SECTOR_ERASE           (0x20U)
-#define SST26_CMD_BULK_ERASE_64K         (0xD8U)
+#define SST26_CMD_BULK_ERASE_64K         (0xD8U)    /* block erase, size by address */
 #define SST26_CMD_CHIP_ERASE             (0xC7U)
 
 #define SST26_CMD_UNPROTECT_GLOBAL       (0x98U)
 
+/* Write suspend/resume (sector/block erase and page program, not chip erase) */
+#define SST26_CMD_WRITE_SUSPEND          (0xB0U)
+#define SST26_CMD_WRITE_RESUME           (0x30U)
+
 /* Status register: WIP bit0 (Harmony uses this) */
 #define SST26_SR_WIP_Msk                 (1U << 0)
+#define SST26_SR_WSE_Msk                 (1U << 2)  /* erase suspended   */
+#define SST26_SR_WSP_Msk                 (1U << 3)  /* program suspended */
 
 /* Device ID used by Harmony demo */
 #define SST26VF064B_JEDEC_ID             (0x004326BFUL)
@@ -42,11 +69,12 @@
 
 #define SST26_SECTOR_SIZE        (4096U)
 #define SST26_PAGE_SIZE          (256U)
-/* Busy polling loop budgets (tuned to be conservative).
-   These are LOOP counts (not ms), matching SST26_WaitWhileBusy(). */
-#define SST26_FT_READY_LOOPS           (2000000UL)
-#define SST26_FT_PAGE_PROG_LOOPS       (3000000UL)
-#define SST26_FT_SECTOR_ERASE_LOOPS    (30000000UL)
+#define SST26_CAPACITY           (8UL * 1024UL * 1024UL)     /* SST26VF064B */
+
+/* D8h block map: 4 x 8K + 1 x 32K at each end, 64K blocks in between */
+#define SST26_BLOCK_SIZE_8K      (0x2000UL)
+#define SST26_BLOCK_SIZE_32K     (0x8000UL)
+#define SST26_BLOCK_SIZE_64K     (0x10000UL)
 
 
 typedef enum
@@ -65,6 +93,21 @@ typedef enum
     SST26_FT_ERR_VERIFY,
 } sst26_fulltest_result_t;
 
+/*
+ * Image source for SST26_ProgramImage: fill buf with len bytes of the image
+ * starting at offset. Called while the previous page programs, so it can
+ * fetch/decode the next chunk for free (up to ~1.5 ms per page).
+ */
+typedef bool (*sst26_image_src_t)(uint8_t *buf, uint32_t len, uint32_t offset, void *ctx);
+
+typedef struct
+{
+    uint32_t bytes;
+    uint32_t erase_units;   /* D8h blocks + 4K sectors */
+    uint32_t total_ms;      /* erase + program + verify */
+    uint32_t milli_mbps;    /* achieved rate, MB/s x 1000 (MB = 2^20) */
+} sst26_image_stats_t;
+
 /* API (mirrors Harmony behavior but keeps your naming style) */
 /* Chip erase can take a long time (seconds to minutes depending on conditions).
  * Keep this generous; callers can use a smaller value if desired. */
@@ -73,20 +116,57 @@ typedef enum
 #endif
 
 bool SST26_ChipErase(uint32_t timeout_ms);
+/* WREN + chip erase only (non-blocking callers poll the status register) */
+bool SST26_ChipEraseStart(void);
+/* Erase/program suspend: returns once BUSY clears (no-op when idle) */
+bool SST26_Suspend(void);
+bool SST26_Resume(void);
 bool SST26_Reset(void);
 bool SST26_EnableQuadIO(void);
+bool SST26_DisableQuadIO(void);
+bool SST26_IsQuadIO(void);
+bool SST26_ReadConfig(uint8_t *cr_out);
+bool SST26_WriteConfig(uint8_t cr);
 bool SST26_WriteEnable(void);
 bool SST26_UnlockGlobal(void);
 
 bool SST26_ReadJEDEC(uint32_t *jedec_out);
 
 bool SST26_ReadStatus(uint8_t *sr_out);
-bool SST26_WaitWhileBusy(uint32_t timeout_loops);
+/* Datasheet-timed wait for op (QSPI_HW_WaitReady with the SST26 timing) */
+bool SST26_WaitWhileBusy(qspi_busy_op_t op);
 
 bool SST26_SectorErase(uint32_t address);
+/* D8h: erases the 8K/32K/64K block containing address (SST26_BlockSize) */
+bool SST26_BlockErase(uint32_t address);
+uint32_t SST26_BlockSize(uint32_t address);
 bool SST26_PageProgram(const void *tx, uint32_t len, uint32_t address);
 bool SST26_HighSpeedRead(void *rx, uint32_t len, uint32_t address);
+bool SST26_HighSpeedReadContinuous(void *rx, uint32_t len, uint32_t address);
+/*
+ * Destructive: erases, programs and verifies [base_addr, base_addr + size).
+ * Like SST26_ProgramImage it drops the read cache for the range, and
+ * QSPI_Flash_Init() has to run again before the object store, log or wear
+ * counters are used.
+ */
 sst26_fulltest_result_t SST26_FullChip_Test(uint32_t base_addr, uint32_t size_bytes);
+/*
+ * Production programming: erase [base_addr, base_addr + len) with the
+ * largest D8h blocks that fit, program it page by page from src and
+ * optionally verify, pipelined like the full-chip test. Blocking; the
+ * flash must not be used by a QSPI job meanwhile. Prints the MB/s achieved.
+ * The erases bypass the job engine, so the object index, log mount and wear
+ * counters do not see them: call QSPI_Flash_Init() again afterwards if the
+ * range overlaps any of them. Cached lines in the range are dropped here.
+ */
+sst26_fulltest_result_t SST26_ProgramImage(uint32_t base_addr, uint32_t len,
+                                           sst26_image_src_t src, void *ctx,
+                                           bool verify, sst26_image_stats_t *stats);
+/* sst26_image_src_t for an image in memory: ctx = image start */
+bool SST26_ImageSrc_Buffer(uint8_t *buf, uint32_t len, uint32_t offset, void *ctx);
+/* Runtime ops table (selected by JEDEC ID in QSPI_Flash_Init) */
+extern const qspi_flash_ops_t g_sst26_flash_ops;
+
 void SST26_ChipErase_Prove(void);
 void SST26_Test_WriteRead_HelloWorld(void);
 void SST26_Test_ChipErase_Timing(void);
@@ -324,6 +324,15 @@ void UART2_DMA_Wait(void)
     }
 }
 
+DmacDescriptor_t *DMA_GetDescriptor(uint8_t channel)
+{
+    if (channel >= DMA_CHANNEL_COUNT)
+    {
+        return NULL;
+    }
+    return &dma_descriptors[channel];
+}
+
 /* ============================================================================
  * Logger Functions (moved from main)
  * ============================================================================ */
@@ -76,6 +76,17 @@ void UART2_DMA_SetCallback(UART2_DMA_Callback_t cb);
  */
 void UART2_DMA_Wait(void);
 
+/* ---------------------------------------------------------------------------
+ * Shared DMAC descriptor tables
+ * --------------------------------------------------------------------------- */
+
+/**
+ * Return the base (first) descriptor of a DMAC channel.
+ * UART2_DMA_Init() owns BASEADDR/WRBADDR and enables the DMAC, so other DMA
+ * users (e.g. QSPI) must run after it and only touch their own channel.
+ */
+DmacDescriptor_t *DMA_GetDescriptor(uint8_t channel);
+
 /* ---------------------------------------------------------------------------
  * Non-blocking logger API (queueing, DMA-driven)
  * --------------------------------------------------------------------------- */
@@ -21,8 +21,34 @@
 #include "drivers/rtcc.h"
 #include "drivers/qspi/sst26/sst26.h"
 #include "drivers/qspi/qspi_flash.h"
+#include "drivers/qspi/qspi_bench.h"
+#include "drivers/qspi/qspi_wear.h"
+#include "drivers/qspi/qspi_log.h"
 #include "common/cpu.h"
 
+/* LED + button + log tasks; also the flash job idle hook, so they keep
+ * running while QSPI_Flash_WriteAddr() waits on an erase/program. */
+static void app_tasks(void)
+{
+    static delay_t t_led = {0,500,0};
+    static sw_t sw0 = {SW0, DEBOUNCE_TIME, 0};
+
+    if (board_sw_pressed(&sw0)) {
+        board_led0_off();
+        if (sw0.cnt % 2 != 0)
+            t_led.period = 100;
+        else
+            t_led.period = 500;
+
+        t_led.t_delay = millis();
+    }
+
+    if (DelayMsAsync(&t_led)) {
+        t_led.cnt++;
+        board_led0_toggle();
+        UART2_DMA_Log("LED0: %s\r\n", board_led0_is_on() ? "ON" : "OFF");
+    }
+}
 
 int main(void)
 { 
@@ -46,30 +72,22 @@ int main(void)
 //    UART2_DMA_Log(banner[0]);
     printf(banner[0]);
 
+    QSPI_Job_SetIdleHook(app_tasks);
     QSPI_FLASH_Example_WriteRead();
+#if QSPI_FLASH_BENCH
+    QSPI_Bench_Run();
+#endif
 
 
     while (1) {
-        static delay_t t_led = {0,500,0};
-        static delay_t t_rtc = {0,1000,0};
-        static sw_t sw0 = {SW0, DEBOUNCE_TIME, 0};
-        
-        if (board_sw_pressed(&sw0)) {
-            board_led0_off();
-            if (sw0.cnt % 2 != 0)
-                t_led.period = 100;
-            else
-                t_led.period = 500;
-
-            t_led.t_delay = millis();
-        }
-
-        if (DelayMsAsync(&t_led)) {
-            t_led.cnt++;
-            board_led0_toggle();
-            UART2_DMA_Log("LED0: %s\r\n", board_led0_is_on() ? "ON" : "OFF");
-        }
-  
+        app_tasks();
+        QSPI_Job_Task();
+#if QSPI_WEAR_ENABLE
+        QSPI_Wear_Task();
+#endif
+#if QSPI_LOG_ENABLE
+        QSPI_Log_Task();
+#endif
     }
 
     return (EXIT_FAILURE);